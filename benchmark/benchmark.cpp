@@ -134,6 +134,14 @@ int main()
     });
     return res;
   };
+  auto reverse_for_each = [] (const auto& c)
+  {
+    unsigned int res=0;
+    std::for_each(c.rbegin(), c.rend(), [&] (auto x) { 
+      res = res * 31 + (unsigned int)x; 
+    });
+    return res;
+  };
   auto insert = [](const auto& c)
   {
     using container_type = 
@@ -154,6 +162,8 @@ int main()
 
   sanity_check<vector, semistable_vector>(for_each);
   sanity_check<vector, list>(for_each);
+  sanity_check<vector, semistable_vector>(reverse_for_each);
+  sanity_check<vector, list>(reverse_for_each);
   sanity_check<vector, semistable_vector>(insert);
   sanity_check<vector, list>(insert);
   sanity_check<vector, semistable_vector>(erase_if_);
@@ -168,6 +178,11 @@ int main()
   test<list>(for_each, base);
   test<semistable_vector>(for_each, base);
 
+  std::cout << "reverse for_each\n";
+  base = test<vector>(reverse_for_each);
+  test<list>(reverse_for_each, base);
+  test<semistable_vector>(reverse_for_each, base);
+
   std::cout << "insert\n";
   base = test<vector>(insert);
   test<list>(insert, base);
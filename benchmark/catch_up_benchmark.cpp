@@ -0,0 +1,79 @@
+/* Time per epoch when an iterator catches up with a long epoch chain.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <semistable/vector.hpp>
+#include <vector>
+
+int main()
+{
+#if defined(SEMISTABLE_NO_PREFETCH)
+  std::cout << "catch-up without prefetching (ns per epoch)\n";
+#else
+  std::cout << "catch-up with prefetching (ns per epoch)\n";
+#endif
+#if defined(SEMISTABLE_COMPACT_EPOCHS)
+  std::cout << "compact epochs\n";
+#endif
+
+  static const int num_trials = 11;
+
+  for(std::size_t n = 1'000; n <= 4'096'000; n *= 4) {
+    using namespace std::chrono;
+    using const_iterator = semistable::vector<int>::const_iterator;
+
+    /* Iterators catch up when dereferenced and also when copied, so each
+     * trial needs its own iterator at the start of the chain.
+     */
+
+    semistable::vector<int>     x(1000);
+    std::vector<const_iterator> its(num_trials, x.cbegin() + 500);
+
+    /* Relocations don't fuse or compose with other epochs, so alternating
+     * insertions at the front and unordered erasures adds an epoch to the
+     * chain on every modification. Interleaved allocations scatter the
+     * epochs across memory as in a long-running program.
+     */
+
+    std::vector<std::unique_ptr<char[]>> junk;
+    std::mt19937_64                      gen(34862);
+    for(std::size_t i = 0; i < n; ++i) {
+      if(i % 2 == 0) x.insert(x.begin(), (int)i);
+      else x.erase_unordered(x.begin());
+      junk.emplace_back(new char[16 + gen() % 240]);
+    }
+    std::shuffle(junk.begin(), junk.end(), gen);
+    junk.resize(junk.size() / 2);
+
+    /* the chain is cold for the first trial, and for the rest too if it
+     * doesn't fit in cache
+     */
+
+    std::array<double, num_trials> trials;
+    volatile int                   res;
+    for(int i = 0; i < num_trials; ++i) {
+      auto t1 = high_resolution_clock::now();
+      res = *its[i];
+      auto t2 = high_resolution_clock::now();
+      trials[i] = duration_cast<duration<double>>(t2 - t1).count();
+    }
+    (void)res;
+    std::sort(trials.begin() + 1, trials.end());
+    std::cout << std::setw(8) << n << ": "
+              << std::setw(8) << trials[0] * 1E9 / (double)n << " (cold)  "
+              << std::setw(8) << trials[num_trials / 2] * 1E9 / (double)n
+              << " (median)\n";
+  }
+}
@@ -0,0 +1,97 @@
+/* Epoch allocations and time per modification with a few live iterators
+ * lagging behind, for the lookback window compiled in
+ * (SEMISTABLE_EPOCH_LOOKBACK).
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <semistable/vector.hpp>
+#include <type_traits>
+#include <vector>
+
+/* counts allocations of anything other than elements, i.e. epochs */
+
+std::size_t num_epoch_allocations = 0;
+
+template<typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() = default;
+  template<typename U>
+  counting_allocator(const counting_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n)
+  {
+    if(!std::is_same<T, int>::value) ++num_epoch_allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  bool operator==(const counting_allocator&) const noexcept { return true; }
+  bool operator!=(const counting_allocator&) const noexcept { return false; }
+};
+
+int main()
+{
+  using namespace std::chrono;
+  using vector = semistable::vector<int, counting_allocator<int>>;
+
+  std::cout << "lookback window " << SEMISTABLE_EPOCH_LOOKBACK
+            << " (epoch allocations per modification, ns per modification)\n";
+
+  static const std::size_t num_edits = 4'000'000;
+
+  for(std::size_t k: {0, 1, 2, 4, 8}) {
+
+    /* Editor-like workload: bursts of typing (insertions after a cursor)
+     * and backspacing (erasures before it), with the cursor jumping now and
+     * then. k iterators are kept as bookmarks, one of them visited every few
+     * edits in round-robin, so they lag behind the head by different
+     * amounts.
+     */
+
+    vector                        x(10'000);
+    std::vector<vector::iterator> its(k, x.begin());
+    std::mt19937_64               gen(34862);
+    std::size_t                   cursor = 5'000, visit = 0;
+    long                          res = 0;
+
+    for(std::size_t i = 0; i < k; ++i) its[i] = x.begin() + (long)(i * 1000);
+    num_epoch_allocations = 0;
+
+    auto t1 = high_resolution_clock::now();
+    for(std::size_t n = 0; n < num_edits; ) {
+      if(gen() % 16 == 0) cursor = 1 + gen() % (x.size() - 1);
+      auto burst = 1 + gen() % 8;
+      bool typing = gen() % 2 == 0 || x.size() < 5'000;
+      for(std::size_t j = 0; j < burst; ++j, ++n) {
+        if(typing) x.insert(x.begin() + (long)cursor++, (int)n);
+        else if(cursor > 1) x.erase(x.begin() + (long)--cursor);
+        if(k && n % 5 == 0) res += *its[visit++ % k];
+      }
+    }
+    auto t2 = high_resolution_clock::now();
+
+    std::cout << "live iterators " << std::setw(2) << k << ": "
+              << std::setw(8) << (double)num_epoch_allocations / num_edits
+              << "  " << std::setw(8)
+              << duration_cast<duration<double>>(t2 - t1).count() * 1E9 /
+                 num_edits
+              << (res == -1? "*": "") << "\n";
+  }
+}
@@ -0,0 +1,191 @@
+/* Time per edit to keep annotations of a text buffer up to date under
+ * random edits, with marker_range vs. eagerly updated position pairs, when
+ * only the annotations in sight are looked at every so often. The time of
+ * a final sweep over all annotations is reported separately: marker_range
+ * then pays for catching up with all the edits at once.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <semistable/marker_range.hpp>
+#include <semistable/vector.hpp>
+#include <utility>
+#include <vector>
+
+static const std::size_t buffer_size = 100'000,
+                         num_edits = 10'000,
+                         edits_per_look = 100, /* a screen refresh */
+                         looks_per_refresh = 20;
+
+struct edit
+{
+  bool        insertion;
+  std::size_t index, n;
+};
+
+std::vector<edit> make_edits(std::size_t n)
+{
+  std::vector<edit> res;
+  std::mt19937_64   gen(2384);
+  std::size_t       size = buffer_size;
+  for(std::size_t i = 0; i < n; ++i) {
+    bool        insertion = gen() % 2 == 0;
+    std::size_t len = 1 + gen() % 16;
+    if(insertion) {
+      res.push_back({true, gen() % (size + 1), len});
+      size += len;
+    }
+    else {
+      std::size_t index = gen() % size;
+      len = (std::min)(len, size - index);
+      res.push_back({false, index, len});
+      size -= len;
+    }
+  }
+  return res;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>>
+make_annotations(std::size_t n)
+{
+  std::vector<std::pair<std::size_t, std::size_t>> res;
+  std::mt19937_64                                  gen(9183);
+  for(std::size_t i = 0; i < n; ++i) {
+    std::size_t first = gen() % buffer_size,
+                last = (std::min)(buffer_size, first + gen() % 200);
+    res.push_back({first, last});
+  }
+  return res;
+}
+
+/* every so often, the annotations in sight (a random subset) are looked at */
+
+template<typename Look>
+void look(std::size_t num_annotations, std::mt19937_64& gen, Look l)
+{
+  for(std::size_t i = 0; i < looks_per_refresh; ++i) {
+    l(gen() % num_annotations);
+  }
+}
+
+struct result
+{
+  double edits, sweep; /* seconds */
+};
+
+result eager(
+  const std::vector<edit>& edits,
+  std::vector<std::pair<std::size_t, std::size_t>> annotations)
+{
+  std::vector<char> x(buffer_size, 'a');
+  std::mt19937_64   gen(1);
+  std::size_t       res = 0;
+
+  auto t1 = std::chrono::high_resolution_clock::now();
+  for(std::size_t i = 0; i < edits.size(); ++i) {
+    const auto& e = edits[i];
+    if(e.insertion) {
+      x.insert(x.begin() + (std::ptrdiff_t)e.index, e.n, 'b');
+      for(auto& a: annotations) {
+        if(a.first > e.index) a.first += e.n;
+        if(a.second >= e.index) a.second += e.n;
+      }
+    }
+    else {
+      x.erase(
+        x.begin() + (std::ptrdiff_t)e.index,
+        x.begin() + (std::ptrdiff_t)(e.index + e.n));
+      auto collapse = [&] (std::size_t pos) {
+        if(pos >= e.index + e.n) return pos - e.n;
+        else if(pos > e.index) return e.index;
+        else return pos;
+      };
+      for(auto& a: annotations) {
+        a.first = collapse(a.first);
+        a.second = collapse(a.second);
+      }
+    }
+    if(i % edits_per_look == 0) {
+      look(annotations.size(), gen, [&] (std::size_t j) {
+        res += annotations[j].second - annotations[j].first;
+      });
+    }
+  }
+  auto t2 = std::chrono::high_resolution_clock::now();
+  for(const auto& a: annotations) res += a.second - a.first;
+  auto t3 = std::chrono::high_resolution_clock::now();
+
+  volatile std::size_t sink = res;
+  (void)sink;
+  return {
+    std::chrono::duration<double>(t2 - t1).count(),
+    std::chrono::duration<double>(t3 - t2).count()};
+}
+
+result lazy(
+  const std::vector<edit>& edits,
+  const std::vector<std::pair<std::size_t, std::size_t>>& annotations)
+{
+  using marker_range = semistable::marker_range<char>;
+
+  semistable::vector<char>  x(buffer_size, 'a');
+  std::vector<marker_range> ranges;
+  for(const auto& a: annotations) ranges.emplace_back(x, a.first, a.second);
+  std::mt19937_64 gen(1);
+  std::size_t     res = 0;
+
+  auto t1 = std::chrono::high_resolution_clock::now();
+  for(std::size_t i = 0; i < edits.size(); ++i) {
+    const auto& e = edits[i];
+    if(e.insertion) {
+      x.insert(x.begin() + (std::ptrdiff_t)e.index, e.n, 'b');
+    }
+    else {
+      x.erase(
+        x.begin() + (std::ptrdiff_t)e.index,
+        x.begin() + (std::ptrdiff_t)(e.index + e.n));
+    }
+    if(i % edits_per_look == 0) {
+      look(ranges.size(), gen, [&] (std::size_t j) {
+        res += ranges[j].size();
+      });
+    }
+  }
+  auto t2 = std::chrono::high_resolution_clock::now();
+  for(const auto& r: ranges) res += r.size();
+  auto t3 = std::chrono::high_resolution_clock::now();
+
+  volatile std::size_t sink = res;
+  (void)sink;
+  return {
+    std::chrono::duration<double>(t2 - t1).count(),
+    std::chrono::duration<double>(t3 - t2).count()};
+}
+
+int main()
+{
+  auto edits = make_edits(num_edits);
+
+  std::cout << "annotation maintenance (" << num_edits << " random edits on a "
+            << buffer_size << "-element buffer)\n"
+            << "               ns per edit          ns per annotation swept\n"
+            << "annotations       eager        lazy       eager        lazy\n";
+  for(std::size_t n = 100; n <= 100'000; n *= 10) {
+    auto annotations = make_annotations(n);
+    auto re = eager(edits, annotations), rl = lazy(edits, annotations);
+    std::cout << std::setw(11) << n << ": "
+              << std::setw(10) << re.edits * 1E9 / num_edits << "  "
+              << std::setw(10) << rl.edits * 1E9 / num_edits << "  "
+              << std::setw(10) << re.sweep * 1E9 / (double)n << "  "
+              << std::setw(10) << rl.sweep * 1E9 / (double)n << std::endl;
+  }
+}
@@ -0,0 +1,134 @@
+/* Over-aligned element storage for semistable::vector.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_ALIGNED_ALLOCATOR_HPP
+#define SEMISTABLE_ALIGNED_ALLOCATOR_HPP
+
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <semistable/vector.hpp>
+
+namespace semistable {
+
+/* Tells the compiler that p is Alignment-aligned, so that loops over it
+ * vectorize without peeling for the unaligned head.
+ */
+
+template<std::size_t Alignment, typename T>
+T* assume_aligned(T* p) noexcept
+{
+#if defined(__cpp_lib_assume_aligned)
+  return std::assume_aligned<Alignment>(p);
+#elif defined(__GNUC__)
+  return static_cast<T*>(__builtin_assume_aligned(p, Alignment));
+#else
+  return p;
+#endif
+}
+
+/* Allocator returning Alignment-aligned storage (say, 64 for cache lines or
+ * AVX-512). Alignment is part of the type and survives rebinding, so a
+ * semistable::vector using it keeps its elements aligned across growth,
+ * shrink_to_fit, copies and moves (as do its epoch descriptors).
+ */
+
+template<typename T, std::size_t Alignment = 64>
+class aligned_allocator
+{
+  static_assert(
+    Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+    "Alignment must be a power of two");
+
+public:
+  using value_type = T;
+  static constexpr std::size_t alignment =
+    Alignment < alignof(T)? alignof(T): Alignment;
+
+  template<typename U>
+  struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+  aligned_allocator() = default;
+  template<typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+  T* allocate(std::size_t n)
+  {
+    if(n > (std::numeric_limits<std::size_t>::max)() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+#if defined(__cpp_aligned_new)
+    return static_cast<T*>(
+      ::operator new(n * sizeof(T), std::align_val_t{alignment}));
+#else
+    /* over-allocate and stash the original pointer right before the
+     * aligned block
+     */
+
+    static constexpr std::size_t
+      a = alignment < alignof(void*)? alignof(void*): alignment,
+      extra = a + sizeof(void*);
+    if(n * sizeof(T) > (std::numeric_limits<std::size_t>::max)() - extra) {
+      throw std::bad_alloc();
+    }
+    void* p = ::operator new(n * sizeof(T) + extra);
+    auto  q = ((std::uintptr_t)p + extra) & ~(std::uintptr_t)(a - 1);
+    reinterpret_cast<void**>(q)[-1] = p;
+    return reinterpret_cast<T*>(q);
+#endif
+  }
+
+  void deallocate(T* p, std::size_t) noexcept
+  {
+#if defined(__cpp_aligned_new)
+    ::operator delete(p, std::align_val_t{alignment});
+#else
+    ::operator delete(reinterpret_cast<void**>(p)[-1]);
+#endif
+  }
+
+  friend bool operator==(
+    const aligned_allocator&, const aligned_allocator&) noexcept
+  {
+    return true;
+  }
+
+  friend bool operator!=(
+    const aligned_allocator&, const aligned_allocator&) noexcept
+  {
+    return false;
+  }
+};
+
+template<typename T, std::size_t Alignment>
+constexpr std::size_t aligned_allocator<T, Alignment>::alignment;
+
+/* x.data() with its alignment made known to the compiler (null if x has
+ * never allocated)
+ */
+
+template<typename T, std::size_t Alignment>
+T* aligned_data(
+  vector<T, aligned_allocator<T, Alignment>>& x) noexcept
+{
+  return assume_aligned<aligned_allocator<T, Alignment>::alignment>(x.data());
+}
+
+template<typename T, std::size_t Alignment>
+const T* aligned_data(
+  const vector<T, aligned_allocator<T, Alignment>>& x) noexcept
+{
+  return assume_aligned<aligned_allocator<T, Alignment>::alignment>(x.data());
+}
+
+} /* namespace semistable */
+
+#endif
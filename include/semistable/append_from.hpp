@@ -0,0 +1,80 @@
+/* Bulk appending to semistable::vector from streams and file descriptors.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_APPEND_FROM_HPP
+#define SEMISTABLE_APPEND_FROM_HPP
+
+#include <boost/config.hpp>
+#include <cstddef>
+#include <istream>
+#include <semistable/vector.hpp>
+#include <type_traits>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <cerrno>
+#include <system_error>
+#include <unistd.h>
+#endif
+
+namespace semistable {
+
+/* Append up to count elements read as raw bytes from the source, stopping
+ * early at end of input (a trailing partial element is discarded) and
+ * returning the number of elements appended. Capacity is reserved once and a
+ * single epoch is published, with data read block by block into
+ * cache-resident storage and copied from there into the vector (see
+ * vector::append_uninitialized). If reading fails with an exception, the
+ * elements already read are kept.
+ */
+
+template<typename T, typename Allocator>
+typename vector<T, Allocator>::size_type
+append_from(
+  vector<T, Allocator>& x, std::istream& is,
+  typename vector<T, Allocator>::size_type count)
+{
+  using size_type = typename vector<T, Allocator>::size_type;
+
+  return x.append_uninitialized(count, [&] (T* p, size_type m) {
+    is.read(reinterpret_cast<char*>(p), (std::streamsize)(m * sizeof(T)));
+    return (size_type)is.gcount() / sizeof(T);
+  });
+}
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+/* Read errors other than EINTR throw std::system_error. */
+
+template<typename T, typename Allocator>
+typename vector<T, Allocator>::size_type
+append_from(
+  vector<T, Allocator>& x, int fd,
+  typename vector<T, Allocator>::size_type count)
+{
+  using size_type = typename vector<T, Allocator>::size_type;
+
+  return x.append_uninitialized(count, [&] (T* p, size_type m) {
+    char        *first = reinterpret_cast<char*>(p);
+    std::size_t  size = m * sizeof(T), n = 0;
+    while(n < size) {
+      auto res = ::read(fd, first + n, size - n);
+      if(res > 0) n += (std::size_t)res;
+      else if(res == 0) break; /* end of file */
+      else if(errno != EINTR) {
+        throw std::system_error{errno, std::generic_category()};
+      }
+    }
+    return (size_type)(n / sizeof(T));
+  });
+}
+
+#endif
+
+} /* namespace semistable */
+
+#endif
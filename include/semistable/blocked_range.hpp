@@ -0,0 +1,102 @@
+/* Splittable range over a semistable::vector for work-stealing schedulers.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_BLOCKED_RANGE_HPP
+#define SEMISTABLE_BLOCKED_RANGE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <semistable/marker_range.hpp>
+#include <semistable/vector.hpp>
+#include <type_traits>
+
+namespace semistable {
+
+/* blocked_range is a marker_range (with the default gravities, so elements
+ * inserted at either end go inside) that can be split down to a grain size,
+ * with the interface of tbb::blocked_range: it can be passed as is to
+ * tbb::parallel_for and similar algorithms of work-stealing schedulers,
+ * which split it through the constructor blocked_range(r, tbb::split{}).
+ * Subranges can be queued across modifications of the vector: each one
+ * catches up with the epoch chain when accessed, typically as its task
+ * starts running, and then yields raw pointers to its elements. Between
+ * them, the subranges cover the elements as of that moment exactly once.
+ * Different subranges can be accessed concurrently, though not while the
+ * vector is being modified.
+ */
+
+template<
+  typename T,
+  typename Allocator = std::allocator<typename std::remove_const<T>::type>
+>
+class blocked_range
+{
+  using range_type = marker_range<T, Allocator>;
+
+public:
+  using value_type = typename range_type::value_type;
+  using size_type = typename range_type::size_type;
+  using iterator = typename range_type::iterator;
+  using const_iterator = iterator;
+
+  blocked_range(vector<value_type, Allocator>& x, size_type grainsize_ = 1):
+    blocked_range{x, 0, x.size(), grainsize_} {}
+
+  blocked_range(
+    vector<value_type, Allocator>& x, size_type first, size_type last,
+    size_type grainsize_ = 1):
+    blocked_range{range_type{x, first, last}, grainsize_} {}
+
+  template<
+    typename Q = T,
+    typename = typename std::enable_if<std::is_const<Q>::value>::type
+  >
+  blocked_range(
+    const vector<value_type, Allocator>& x, size_type grainsize_ = 1):
+    blocked_range{x, 0, x.size(), grainsize_} {}
+
+  template<
+    typename Q = T,
+    typename = typename std::enable_if<std::is_const<Q>::value>::type
+  >
+  blocked_range(
+    const vector<value_type, Allocator>& x, size_type first, size_type last,
+    size_type grainsize_ = 1):
+    blocked_range{range_type{x, first, last}, grainsize_} {}
+
+  /* splitting constructor: r keeps its first half, *this takes the second */
+
+  template<
+    typename Split,
+    typename = typename std::enable_if<std::is_empty<Split>::value>::type
+  >
+  blocked_range(blocked_range& r, Split):
+    blocked_range{r.rng.split(), r.grain} {}
+
+  iterator  begin() const noexcept { return rng.begin(); }
+  iterator  end() const noexcept { return rng.end(); }
+  size_type size() const noexcept { return rng.size(); }
+  bool      empty() const noexcept { return rng.empty(); }
+  size_type grainsize() const noexcept { return grain; }
+  bool      is_divisible() const noexcept { return size() > grain; }
+
+  /* *this keeps the first half, the second one is returned */
+
+  blocked_range split() noexcept { return {rng.split(), grain}; }
+
+private:
+  blocked_range(range_type&& rng_, size_type grainsize_) noexcept:
+    rng{std::move(rng_)}, grain{grainsize_ > 0? grainsize_: 1} {}
+
+  range_type rng;
+  size_type  grain;
+};
+
+} /* namespace semistable */
+
+#endif
@@ -0,0 +1,686 @@
+/* Semistable circular buffer.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_CIRCULAR_BUFFER_HPP
+#define SEMISTABLE_CIRCULAR_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <semistable/vector.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace semistable {
+
+template<typename T, typename Allocator = std::allocator<T>>
+class circular_buffer;
+
+namespace detail {
+
+/* Iterators of circular_buffer track sequence numbers: elements are
+ * numbered consecutively from the oldest, and numbers are kept when older
+ * elements are overwritten or popped, so only insertions and erasures
+ * before an element (which shift the numbers of the elements after them)
+ * are recorded in the epoch chain. An iterator whose number falls behind
+ * the oldest element is no longer valid().
+ *
+ * Sequence numbers are 64-bit so that they don't wrap around (and stale
+ * iterators don't come back into range) where std::size_t is 32-bit.
+ * Epochs record them modulo std::size_t, which is enough to tell which
+ * side of an epoch an element is on, as both lie within the buffer.
+ */
+
+using circular_sequence = std::uint64_t;
+
+/* shared by the iterators of all element types, see catch_up_element */
+
+template<typename Allocator>
+circular_sequence catch_up_sequence(
+  epoch_pointer<Allocator>& pe, circular_sequence s) noexcept
+{
+  catch_up(pe, [&] (const epoch_node<Allocator>& e) {
+    if((std::ptrdiff_t)((std::size_t)s - e.index) >= 0) s += e.offset;
+  });
+  return s;
+}
+
+template<typename T, typename Allocator>
+class circular_iterator
+{
+  using value_type_ = typename std::remove_const<T>::type;
+  using container_type = semistable::circular_buffer<value_type_, Allocator>;
+  using epoch_pointer = detail::epoch_pointer<
+    detail::epoch_allocator<Allocator>>;
+  template<typename Q>
+  using enable_if_consts_to_value_type_t =
+    typename std::enable_if<std::is_same<const Q, T>::value>::type;
+
+public:
+  using value_type = value_type_;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+  using iterator_category = std::random_access_iterator_tag;
+
+  circular_iterator() noexcept: seq{0}, pe{}, pc{nullptr} {}
+  circular_iterator(const circular_iterator& x) noexcept:
+    seq{x.index()}, pe{x.pe}, pc{x.pc} {}
+  circular_iterator(circular_iterator&& x) noexcept:
+    seq{x.index()}, pe{std::move(x.pe)}, pc{x.pc} {}
+
+  template<
+    typename Q,
+    typename = enable_if_consts_to_value_type_t<Q>
+  >
+  circular_iterator(const circular_iterator<Q, Allocator>& x) noexcept:
+    seq{x.index()}, pe{x.pe}, pc{x.pc} {}
+
+  circular_iterator& operator=(const circular_iterator& x) noexcept
+  {
+    seq = x.index();
+    pe = x.pe;
+    pc = x.pc;
+    return *this;
+  }
+
+  circular_iterator& operator=(circular_iterator&& x) noexcept
+  {
+    seq = x.index();
+    pe = std::move(x.pe);
+    pc = x.pc;
+    return *this;
+  }
+
+  template<
+    typename Q,
+    typename = enable_if_consts_to_value_type_t<Q>
+  >
+  circular_iterator& operator=(const circular_iterator<Q, Allocator>& x)
+    noexcept
+  {
+    seq = x.index();
+    pe = x.pe;
+    pc = x.pc;
+    return *this;
+  }
+
+  /* false if the element was overwritten or popped from the front */
+
+  bool valid() const noexcept
+  {
+    return pc && index() - pc->first_seq <= pc->sz;
+  }
+
+  pointer operator->() const noexcept
+  {
+    return pc->slot(index());
+  }
+
+  reference operator*() const noexcept
+  {
+    return *operator->();
+  }
+
+  circular_iterator& operator++() noexcept
+  {
+    ++index();
+    return *this;
+  }
+
+  circular_iterator operator++(int) noexcept
+  {
+    circular_iterator tmp(*this);
+    ++index();
+    return tmp;
+  }
+
+  circular_iterator& operator--() noexcept
+  {
+    --index();
+    return *this;
+  }
+
+  circular_iterator operator--(int) noexcept
+  {
+    circular_iterator tmp(*this);
+    --index();
+    return tmp;
+  }
+
+  friend difference_type
+  operator-(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return (difference_type)(x.index() - y.index());
+  }
+
+  circular_iterator& operator+=(difference_type n) noexcept
+  {
+    index() += n;
+    return *this;
+  }
+
+  friend circular_iterator
+  operator+(const circular_iterator& x, difference_type n) noexcept
+  {
+    return {x.index() + n, x.pe, x.pc};
+  }
+
+  friend circular_iterator
+  operator+(difference_type n, const circular_iterator& x) noexcept
+  {
+    return {n + x.index(), x.pe, x.pc};
+  }
+
+  circular_iterator& operator-=(difference_type n) noexcept
+  {
+    index() -= n;
+    return *this;
+  }
+
+  friend circular_iterator
+  operator-(const circular_iterator& x, difference_type n) noexcept
+  {
+    return {x.index() - n, x.pe, x.pc};
+  }
+
+  reference operator[](difference_type n) const noexcept
+  {
+    return *pc->slot(index() + n);
+  }
+
+  friend bool
+  operator==(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return x.index() == y.index();
+  }
+
+  friend bool
+  operator!=(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return x.index() != y.index();
+  }
+
+  friend bool
+  operator<(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return x.index() < y.index();
+  }
+
+  friend bool
+  operator>(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return x.index() > y.index();
+  }
+
+  friend bool
+  operator<=(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return x.index() <= y.index();
+  }
+
+  friend bool
+  operator>=(const circular_iterator& x, const circular_iterator& y) noexcept
+  {
+    return x.index() >= y.index();
+  }
+
+private:
+  template<typename, typename> friend class circular_iterator;
+  template<typename, typename> friend class semistable::circular_buffer;
+
+  circular_iterator(
+    circular_sequence seq_, const epoch_pointer& pe_,
+    const container_type* pc_) noexcept:
+    seq{seq_}, pe{pe_}, pc{pc_} {}
+
+  void update() const noexcept
+  {
+    /* value-initialized iterators have no epoch */
+
+    if(pe && BOOST_UNLIKELY(pe->next.get() != nullptr)) {
+      seq = detail::catch_up_sequence(pe, seq);
+    }
+  }
+
+  circular_sequence& index() const noexcept
+  {
+    update();
+    return seq;
+  }
+
+  mutable circular_sequence seq;
+  mutable epoch_pointer     pe;
+  const container_type* pc;
+};
+
+} /* namespace detail */
+
+/* Fixed-capacity ring of elements where pushing at the back of a full
+ * buffer overwrites the oldest element. Iterators stay with their element
+ * through pushes, pops and erasures, and can tell whether their element
+ * has been overwritten or popped from the front with valid(). Elements
+ * are stored in (at most) two contiguous runs, array_one() and
+ * array_two(). Unlike semistable::vector, iterators refer to their
+ * container, so they stay with it on move and swap (and are invalidated
+ * by them).
+ */
+
+template<typename T, typename Allocator>
+class circular_buffer
+{
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using epoch_node = detail::epoch_node<detail::epoch_allocator<Allocator>>;
+  using epoch_type = typename epoch_node::epoch_type;
+  using epoch_pointer = detail::epoch_pointer<
+    detail::epoch_allocator<Allocator>>;
+
+  static_assert(
+    !std::is_const<T>::value && !std::is_volatile<T>::value &&
+    !std::is_function<T>::value && !std::is_reference<T>::value &&
+    !std::is_void<T>::value,
+    "T must be a cv-unqualified object type");
+  static_assert(
+    std::is_same<T, typename alloc_traits::value_type>::value,
+    "Allocator's value_type must be the same type as T");
+  static_assert(
+    sizeof(detail::epoch_shift::index_type) == sizeof(std::size_t),
+    "sequence numbers don't fit in the compact epochs enabled by "
+    "SEMISTABLE_COMPACT_EPOCHS");
+
+public:
+  /* types */
+
+  using value_type = T;
+  using allocator_type = Allocator;
+  using pointer = typename alloc_traits::pointer;
+  using const_pointer = typename alloc_traits::const_pointer;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = typename alloc_traits::size_type;
+  using difference_type = typename alloc_traits::difference_type;
+  using iterator = detail::circular_iterator<T, Allocator>;
+  using const_iterator = detail::circular_iterator<const T, Allocator>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using array_range = std::pair<T*, size_type>;
+  using const_array_range = std::pair<const T*, size_type>;
+
+  /* construct/copy/destroy */
+
+  explicit circular_buffer(size_type capacity_, const Allocator& al_ = {}):
+    al{al_}, buf{allocate(capacity_)}, cap{capacity_} {}
+
+  circular_buffer(const circular_buffer& x):
+    circular_buffer{
+      x.cap, alloc_traits::select_on_container_copy_construction(x.al)}
+  {
+    for(const auto& v: x) push_back(v);
+  }
+
+  /* iterators into x are invalidated */
+
+  circular_buffer(circular_buffer&& x):
+    al{x.al}, buf{x.buf}, cap{x.cap}, first{x.first}, sz{x.sz}
+  {
+    x.renumber(x.first_seq + x.sz);
+    x.buf = pointer();
+    x.cap = 0;
+    x.first = 0;
+    x.sz = 0;
+  }
+
+  ~circular_buffer()
+  {
+    destroy_all();
+    deallocate();
+  }
+
+  circular_buffer& operator=(const circular_buffer& x)
+  {
+    if(this != &x) {
+      circular_buffer tmp{x};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  circular_buffer& operator=(circular_buffer&& x)
+  {
+    if(this != &x) {
+      circular_buffer tmp{std::move(x)};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return al; }
+
+  /* iterators */
+
+  iterator               begin() noexcept { return {first_seq, pe, this}; }
+  const_iterator         begin() const noexcept
+                         { return {first_seq, pe, this}; }
+  iterator               end() noexcept { return {first_seq + sz, pe, this}; }
+  const_iterator         end() const noexcept
+                         { return {first_seq + sz, pe, this}; }
+  reverse_iterator       rbegin() noexcept { return reverse_iterator{end()}; }
+  const_reverse_iterator rbegin() const noexcept
+                         { return const_reverse_iterator{end()}; }
+  reverse_iterator       rend() noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator rend() const noexcept
+                         { return const_reverse_iterator{begin()}; }
+
+  const_iterator         cbegin() const noexcept { return begin(); }
+  const_iterator         cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  /* capacity */
+
+  bool      empty() const noexcept { return sz == 0; }
+  bool      full() const noexcept { return sz == cap; }
+  size_type size() const noexcept { return sz; }
+  size_type capacity() const noexcept { return cap; }
+
+  size_type max_size() const noexcept
+  {
+    return alloc_traits::max_size(al);
+  }
+
+  /* element access */
+
+  reference       operator[](size_type n) { return *slot(first_seq + n); }
+  const_reference operator[](size_type n) const
+                  { return *slot(first_seq + n); }
+
+  reference at(size_type n)
+  {
+    if(n >= sz) throw std::out_of_range("circular_buffer::at");
+    return (*this)[n];
+  }
+
+  const_reference at(size_type n) const
+  {
+    if(n >= sz) throw std::out_of_range("circular_buffer::at");
+    return (*this)[n];
+  }
+
+  reference       front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference       back() { return (*this)[sz - 1]; }
+  const_reference back() const { return (*this)[sz - 1]; }
+
+  /* the elements, from the oldest, as two contiguous runs */
+
+  array_range array_one() noexcept
+  {
+    return {data() + first, (std::min)(sz, cap - first)};
+  }
+
+  const_array_range array_one() const noexcept
+  {
+    return {data() + first, (std::min)(sz, cap - first)};
+  }
+
+  array_range array_two() noexcept
+  {
+    return {data(), sz - (std::min)(sz, cap - first)};
+  }
+
+  const_array_range array_two() const noexcept
+  {
+    return {data(), sz - (std::min)(sz, cap - first)};
+  }
+
+  /* modifiers: the strong exception guarantee is provided as long as T's
+   * moves don't throw, except for erase (basic guarantee)
+   */
+
+  /* if the buffer is full, the oldest element is overwritten */
+
+  template<typename... Args>
+  void emplace_back(Args&&... args)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    if(cap == 0) return;
+    auto e = make_epoch(first_seq + sz, 1);
+    auto next = make_epoch_pointer(e);
+    if(sz < cap) {
+      construct(slot(first_seq + sz), std::forward<Args>(args)...);
+      ++sz;
+    }
+    else {
+      /* assigned rather than destroyed and reconstructed so that the slot
+       * is still alive if T's move throws
+       */
+
+      T tmp(std::forward<Args>(args)...);
+      *slot(first_seq) = std::move(tmp);
+      advance_first();
+      ++sz;
+    }
+    publish(std::move(next), e);
+  }
+
+  void push_back(const T& x) { emplace_back(x); }
+  void push_back(T&& x) { emplace_back(std::move(x)); }
+
+  /* iterators to the popped element become invalid, no epoch needed */
+
+  void pop_front() noexcept
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    destroy(slot(first_seq));
+    advance_first();
+  }
+
+  void pop_back()
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto e = make_epoch(first_seq + sz, -1);
+    auto next = make_epoch_pointer(e);
+    destroy(slot(first_seq + sz - 1));
+    --sz;
+    publish(std::move(next), e);
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first_, const_iterator last_)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto fseq = first_.index(),
+         lseq = last_.index(),
+         eseq = first_seq + sz;
+    if(fseq == lseq) return {fseq, pe, this};
+    auto e = make_epoch(lseq, -(difference_type)(lseq - fseq));
+    auto next = make_epoch_pointer(e);
+    auto s = fseq;
+    for(auto t = lseq; t != eseq; ++s, ++t) *slot(s) = std::move(*slot(t));
+    for(auto t = s; t != eseq; ++t) destroy(slot(t));
+    sz -= lseq - fseq;
+    publish(std::move(next), e);
+    return {fseq, pe, this};
+  }
+
+  /* iterators to the elements (but not end()) become invalid */
+
+  void clear() noexcept
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    while(sz) pop_front();
+  }
+
+  /* elements are swapped, iterators stay with (and are invalidated by)
+   * their container
+   */
+
+  void swap(circular_buffer& x) noexcept
+  {
+    SEMISTABLE_CHECK_INVARIANT_OF(*this);
+    SEMISTABLE_CHECK_INVARIANT_OF(x);
+    using std::swap;
+    renumber(first_seq + sz);
+    x.renumber(x.first_seq + x.sz);
+    if(alloc_traits::propagate_on_container_swap::value) swap(al, x.al);
+    swap(buf, x.buf);
+    swap(cap, x.cap);
+    swap(first, x.first);
+    swap(sz, x.sz);
+  }
+
+private:
+  template<typename, typename> friend class detail::circular_iterator;
+  friend struct detail::access;
+
+  using sequence_type = detail::circular_sequence;
+
+  T* data() const noexcept { return detail::to_address(buf); }
+
+  T* slot(sequence_type seq) const noexcept
+  {
+    auto n = first + (size_type)(seq - first_seq);
+    if(n >= cap) n -= cap;
+    return data() + n;
+  }
+
+  /* epochs hold sequence numbers modulo std::size_t */
+
+  static epoch_type make_epoch(
+    sequence_type seq, difference_type offset) noexcept
+  {
+    return {nullptr, (std::size_t)seq, offset};
+  }
+
+  void advance_first() noexcept
+  {
+    ++first_seq;
+    if(++first == cap) first = 0;
+    --sz;
+  }
+
+  /* Numbers the elements past the end sequence number of all outstanding
+   * iterators, which become invalid. Later epochs can't shift them back
+   * into range, as they only affect numbers at or after first_seq.
+   */
+
+  void renumber(sequence_type end_seq) noexcept
+  {
+    first_seq = end_seq + 1;
+  }
+
+  pointer allocate(size_type n)
+  {
+    return n? alloc_traits::allocate(al, n): pointer();
+  }
+
+  void deallocate() noexcept
+  {
+    if(buf) alloc_traits::deallocate(al, buf, cap);
+  }
+
+  template<typename... Args>
+  void construct(T* p, Args&&... args)
+  {
+    alloc_traits::construct(al, p, std::forward<Args>(args)...);
+  }
+
+  void destroy(T* p) noexcept
+  {
+    alloc_traits::destroy(al, p);
+  }
+
+  void destroy_all() noexcept
+  {
+    for(sequence_type s = first_seq, e = first_seq + sz; s != e; ++s) {
+      destroy(slot(s));
+    }
+  }
+
+  /* When no iterator is at the head epoch (which is then referred to only
+   * by the container and by pe1->next), the change is fused into it if
+   * possible rather than allocating a new epoch, so that consecutive
+   * push_backs don't grow the chain.
+   */
+
+  epoch_pointer make_epoch_pointer(const detail::epoch_shift& e)
+  {
+    detail::epoch_shift s = *pe;
+    if(pe.use_count() == (pe1? 2: 1) && s.try_fuse(e)) {
+      SEMISTABLE_PROBE(epoch_fuse);
+      return {};
+    }
+    SEMISTABLE_PROBE(epoch_allocate);
+    return epoch_pointer::allocate(al);
+  }
+
+  void publish(epoch_pointer&& next, const epoch_type& e) noexcept
+  {
+    SEMISTABLE_PROBE2(epoch_publish, e.index, e.offset);
+    if(!next) {
+      pe->epoch_shift::try_fuse(e);
+    }
+    else {
+      *next = e;
+      pe->next = next;
+      pe1 = std::move(pe);
+      pe = std::move(next);
+    }
+  }
+
+#if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
+  bool check_invariant() const noexcept
+  {
+    return
+      sz <= cap && (cap == 0 || first < cap) &&
+      pe && !pe->next && (!pe1 || pe1->next == pe);
+  }
+#endif
+
+  Allocator     al;
+  pointer       buf;
+  size_type     cap;
+  size_type     first = 0;     /* position of the oldest element in buf */
+  size_type     sz = 0;
+  sequence_type first_seq = 0; /* sequence number of the oldest element */
+  epoch_pointer pe = epoch_pointer::allocate(al, epoch_type{}),
+                pe1;           /* prior epoch */
+};
+
+template<typename T, typename Allocator>
+bool operator==(
+  const circular_buffer<T, Allocator>& x,
+  const circular_buffer<T, Allocator>& y)
+{
+  return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template<typename T, typename Allocator>
+bool operator!=(
+  const circular_buffer<T, Allocator>& x,
+  const circular_buffer<T, Allocator>& y)
+{
+  return !(x == y);
+}
+
+template<typename T, typename Allocator>
+void swap(circular_buffer<T, Allocator>& x, circular_buffer<T, Allocator>& y)
+{
+  x.swap(y);
+}
+
+} /* namespace semistable */
+
+#endif
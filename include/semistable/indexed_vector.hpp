@@ -0,0 +1,503 @@
+/* Semistable vector with a hash index on a key of its elements.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_INDEXED_VECTOR_HPP
+#define SEMISTABLE_INDEXED_VECTOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <semistable/vector.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace semistable {
+
+namespace detail {
+
+template<typename T, typename KeyOf>
+using key_of_t = typename std::decay<
+  decltype(std::declval<const KeyOf&>()(std::declval<const T&>()))>::type;
+
+} /* namespace detail */
+
+/* indexed_vector is a semistable::vector of elements with unique keys (as
+ * extracted by KeyOf) plus an open-addressing hash index mapping keys to
+ * positions. Index entries are semistable iterators, so insertions and
+ * erasures don't rewrite them: they catch up with the epoch chain when
+ * looked up (also when probed by insertions), walking one epoch per
+ * modification since the index was last rebuilt, so lookups cost O(n) in
+ * the worst case. To keep the chain from growing indefinitely, the index is
+ * rebuilt from the elements in a single pass after as many modifications as
+ * half its buckets (at least as many as elements), which costs amortized
+ * O(1) per modification; catching up every entry instead would cost O(n)
+ * per entry. KeyOf and Hash must not throw when rebuilding.
+ * As with a set, elements are accessed as const so that keys can't be
+ * changed behind the index.
+ */
+
+template<
+  typename T, typename KeyOf,
+  typename Hash = std::hash<detail::key_of_t<T, KeyOf>>,
+  typename Pred = std::equal_to<detail::key_of_t<T, KeyOf>>,
+  typename Allocator = std::allocator<T>
+>
+class indexed_vector
+{
+  using vector_type = semistable::vector<T, Allocator>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+  /* types */
+
+  using key_type = detail::key_of_t<T, KeyOf>;
+  using value_type = T;
+  using key_of = KeyOf;
+  using hasher = Hash;
+  using key_equal = Pred;
+  using allocator_type = Allocator;
+  using reference = const T&;
+  using const_reference = const T&;
+  using size_type = typename vector_type::size_type;
+  using difference_type = typename vector_type::difference_type;
+  using iterator = typename vector_type::const_iterator;
+  using const_iterator = typename vector_type::const_iterator;
+  using reverse_iterator = typename vector_type::const_reverse_iterator;
+  using const_reverse_iterator =
+    typename vector_type::const_reverse_iterator;
+
+  /* construct/copy/destroy */
+
+  indexed_vector(): indexed_vector{Allocator()} {}
+
+  explicit indexed_vector(
+    const Allocator& al, const KeyOf& kf = KeyOf(), const Hash& h = Hash(),
+    const Pred& eq = Pred()):
+    vec{al}, slots{slot_allocator{al}}, kof{kf}, hash{h}, pred{eq} {}
+
+  /* as with std::unordered_set, only the first of equivalent elements is
+   * inserted
+   */
+
+  template<
+    typename InputIterator,
+    typename = typename std::enable_if<
+      std::is_convertible<
+        typename std::iterator_traits<InputIterator>::iterator_category,
+        std::input_iterator_tag
+      >::value
+    >::type
+  >
+  indexed_vector(
+    InputIterator first, InputIterator last,
+    const Allocator& al = Allocator()):
+    indexed_vector{al}
+  {
+    for(; first != last; ++first) push_back(*first);
+  }
+
+  indexed_vector(
+    std::initializer_list<T> il, const Allocator& al = Allocator()):
+    indexed_vector{il.begin(), il.end(), al} {}
+
+  indexed_vector(const indexed_vector& x):
+    vec{x.vec}, slots{x.slots.get_allocator()},
+    kof{x.kof}, hash{x.hash}, pred{x.pred}
+  {
+    rebuild();
+  }
+
+  indexed_vector(indexed_vector&&) = default;
+
+  indexed_vector& operator=(const indexed_vector& x)
+  {
+    if(this != &x) {
+      vec = x.vec;
+      kof = x.kof;
+      hash = x.hash;
+      pred = x.pred;
+      rebuild();
+    }
+    return *this;
+  }
+
+  indexed_vector& operator=(indexed_vector&&) = default;
+
+  allocator_type get_allocator() const noexcept { return vec.get_allocator(); }
+
+  /* the underlying semistable::vector */
+
+  const vector_type& values() const noexcept { return vec; }
+
+  /* iterators */
+
+  const_iterator         begin() const noexcept { return vec.cbegin(); }
+  const_iterator         end() const noexcept { return vec.cend(); }
+  const_reverse_iterator rbegin() const noexcept { return vec.crbegin(); }
+  const_reverse_iterator rend() const noexcept { return vec.crend(); }
+  const_iterator         cbegin() const noexcept { return vec.cbegin(); }
+  const_iterator         cend() const noexcept { return vec.cend(); }
+  const_reverse_iterator crbegin() const noexcept { return vec.crbegin(); }
+  const_reverse_iterator crend() const noexcept { return vec.crend(); }
+
+  /* capacity */
+
+  bool      empty() const noexcept { return vec.empty(); }
+  size_type size() const noexcept { return vec.size(); }
+  size_type capacity() const noexcept { return vec.capacity(); }
+
+  void reserve(size_type n)
+  {
+    vec.reserve(n);
+    reserve_slots(n);
+  }
+
+  /* element access */
+
+  const_reference operator[](size_type n) const { return vec[n]; }
+  const_reference at(size_type n) const { return vec.at(n); }
+  const_reference front() const { return vec.front(); }
+  const_reference back() const { return vec.back(); }
+  const T*        data() const noexcept { return vec.data(); }
+
+  /* lookup */
+
+  const_iterator find(const key_type& k) const
+  {
+    auto n = find_slot(k, hash_of(k));
+    return n == slots.size()? vec.cend(): slots[n].it;
+  }
+
+  size_type count(const key_type& k) const
+  {
+    return find_slot(k, hash_of(k)) == slots.size()? 0: 1;
+  }
+
+  bool contains(const key_type& k) const { return count(k) != 0; }
+
+  /* modifiers: insertion of an element whose key is already in the vector
+   * does nothing and returns the position of the existing element
+   */
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace_back(Args&&... args)
+  {
+    return emplace(cend(), std::forward<Args>(args)...);
+  }
+
+  std::pair<iterator, bool> push_back(const T& x)
+  {
+    return insert(cend(), x);
+  }
+
+  std::pair<iterator, bool> push_back(T&& x)
+  {
+    return insert(cend(), std::move(x));
+  }
+
+  void pop_back() { erase(cend() - 1); }
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace(const_iterator pos, Args&&... args)
+  {
+    return insert(pos, T(std::forward<Args>(args)...));
+  }
+
+  std::pair<iterator, bool> insert(const_iterator pos, const T& x)
+  {
+    return insert_impl(pos, x);
+  }
+
+  std::pair<iterator, bool> insert(const_iterator pos, T&& x)
+  {
+    return insert_impl(pos, std::move(x));
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto findex = (size_type)(first - cbegin()),
+         lindex = (size_type)(last - cbegin());
+    for(auto i = findex; i != lindex; ++i) erase_slot(vec[i]);
+
+    /* value_type's move assignment threw midway (basic guarantee) */
+
+    struct reindexer
+    {
+      ~reindexer()
+      {
+        if(active) x.reindex();
+      }
+
+      indexed_vector& x;
+      bool            active;
+    } r{*this, true};
+    auto res = vec.erase(first, last);
+    r.active = false;
+    modified();
+    return res;
+  }
+
+  size_type erase(const key_type& k)
+  {
+    auto it = find(k);
+    if(it == cend()) return 0;
+    erase(it);
+    return 1;
+  }
+
+  void swap(indexed_vector& x)
+  {
+    using std::swap;
+    vec.swap(x.vec);
+    slots.swap(x.slots);
+    swap(num_modifications, x.num_modifications);
+    swap(kof, x.kof);
+    swap(hash, x.hash);
+    swap(pred, x.pred);
+  }
+
+  void clear()
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    vec.clear();
+    for(auto& s: slots) s.reset();
+    num_modifications = 0;
+  }
+
+  /* observers */
+
+  key_of    key_extractor() const { return kof; }
+  hasher    hash_function() const { return hash; }
+  key_equal key_eq() const { return pred; }
+
+private:
+  friend struct detail::access;
+
+  /* The iterator is only constructed in full slots, as value-initialized
+   * semistable iterators can't be copied.
+   */
+
+  struct slot
+  {
+    slot() noexcept {}
+    slot(slot&& x) noexcept { take(x); }
+    slot& operator=(slot&&) = delete;
+    ~slot() { reset(); }
+
+    void assign(const const_iterator& it_, std::size_t hash_) noexcept
+    {
+      ::new ((void*)std::addressof(it)) const_iterator(it_);
+      hash = hash_;
+      full = true;
+    }
+
+    void take(slot& x) noexcept
+    {
+      if(x.full) {
+        ::new ((void*)std::addressof(it)) const_iterator(std::move(x.it));
+        hash = x.hash;
+        full = true;
+        x.reset();
+      }
+    }
+
+    void reset() noexcept
+    {
+      if(full) {
+        it.~const_iterator();
+        full = false;
+      }
+    }
+
+    union { const_iterator it; };
+    std::size_t hash = 0;
+    bool        full = false;
+  };
+
+  using slot_allocator =
+    typename alloc_traits::template rebind_alloc<slot>;
+  using slot_vector = std::vector<slot, slot_allocator>;
+
+  /* std::hash is often the identity for integers, so low bits are mixed
+   * with high ones
+   */
+
+  std::size_t hash_of(const key_type& k) const
+  {
+    auto h = (unsigned long long)hash(k) * 0x9E3779B97F4A7C15ull;
+    return (std::size_t)(h ^ (h >> 32));
+  }
+
+  std::size_t mask() const noexcept { return slots.size() - 1; }
+
+  /* returns slots.size() if not found */
+
+  std::size_t find_slot(const key_type& k, std::size_t h) const
+  {
+    if(slots.empty()) return 0;
+    for(auto n = h & mask(); ; n = (n + 1) & mask()) {
+      const auto& s = slots[n];
+      if(!s.full) return slots.size();
+      if(s.hash == h && pred(kof(*s.it), k)) return n;
+    }
+  }
+
+  void place(const const_iterator& it, std::size_t h) noexcept
+  {
+    auto n = h & mask();
+    while(slots[n].full) n = (n + 1) & mask();
+    slots[n].assign(it, h);
+  }
+
+  /* backward shift deletion, so that no tombstones are needed */
+
+  void erase_slot(const T& x)
+  {
+    const auto& k = kof(x);
+    auto        n = find_slot(k, hash_of(k));
+    slots[n].reset();
+    for(auto m = n; ; ) {
+      m = (m + 1) & mask();
+      auto& s = slots[m];
+      if(!s.full) break;
+      if(((m - (s.hash & mask())) & mask()) >= ((m - n) & mask())) {
+        slots[n].take(s);
+        n = m;
+      }
+    }
+  }
+
+  /* load factor kept at or below 1/2 */
+
+  void reserve_slots(size_type n)
+  {
+    if(n <= slots.size() / 2) return;
+    std::size_t m = 8;
+    while(n > m / 2) m *= 2;
+    slot_vector new_slots(m, slots.get_allocator());
+    for(auto& s: slots) {
+      if(s.full) {
+        auto n = s.hash & (m - 1);
+        while(new_slots[n].full) n = (n + 1) & (m - 1);
+        new_slots[n].take(s);
+      }
+    }
+    slots.swap(new_slots);
+  }
+
+  void rebuild()
+  {
+    slot_vector new_slots(slots.get_allocator());
+    slots.swap(new_slots);
+    reserve_slots(vec.size());
+    reindex();
+  }
+
+  /* elements with duplicate keys (only possible after an exception) are
+   * left out of the index
+   */
+
+  void reindex()
+  {
+    for(auto& s: slots) s.reset();
+    num_modifications = 0;
+    for(auto it = vec.cbegin(), last = vec.cend(); it != last; ++it) {
+      const auto& k = kof(*it);
+      auto        h = hash_of(k);
+      if(find_slot(k, h) == slots.size()) place(it, h);
+    }
+  }
+
+  template<typename Value>
+  std::pair<iterator, bool> insert_impl(const_iterator pos, Value&& x)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    const auto& k = kof(x);
+    auto        h = hash_of(k);
+    auto        n = find_slot(k, h);
+    if(n != slots.size()) return {slots[n].it, false};
+    reserve_slots(vec.size() + 1);
+    auto it = vec.insert(pos, std::forward<Value>(x));
+    place(it, h);
+    modified();
+    return {it, true};
+  }
+
+  /* Rebuilds the index once the epoch chain behind it is as long as half
+   * its buckets. Keys are known to be unique, so entries are placed without
+   * lookup.
+   */
+
+  void modified() noexcept
+  {
+    if(++num_modifications > slots.size() / 2) {
+      for(auto& s: slots) s.reset();
+      for(auto it = vec.cbegin(), last = vec.cend(); it != last; ++it) {
+        place(it, hash_of(kof(*it)));
+      }
+      num_modifications = 0;
+    }
+  }
+
+#if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
+  bool check_invariant() const noexcept
+  {
+    return vec.size() <= slots.size() / 2;
+  }
+#endif
+
+  vector_type vec;
+  slot_vector slots;
+  size_type   num_modifications = 0;
+  KeyOf       kof;
+  Hash        hash;
+  Pred        pred;
+};
+
+template<
+  typename T, typename KeyOf, typename Hash, typename Pred, typename Allocator
+>
+bool operator==(
+  const indexed_vector<T, KeyOf, Hash, Pred, Allocator>& x,
+  const indexed_vector<T, KeyOf, Hash, Pred, Allocator>& y)
+{
+  return x.values() == y.values();
+}
+
+template<
+  typename T, typename KeyOf, typename Hash, typename Pred, typename Allocator
+>
+bool operator!=(
+  const indexed_vector<T, KeyOf, Hash, Pred, Allocator>& x,
+  const indexed_vector<T, KeyOf, Hash, Pred, Allocator>& y)
+{
+  return !(x == y);
+}
+
+template<
+  typename T, typename KeyOf, typename Hash, typename Pred, typename Allocator
+>
+void swap(
+  indexed_vector<T, KeyOf, Hash, Pred, Allocator>& x,
+  indexed_vector<T, KeyOf, Hash, Pred, Allocator>& y)
+{
+  x.swap(y);
+}
+
+} /* namespace semistable */
+
+#endif
@@ -0,0 +1,345 @@
+/* Jagged array of semistable rows flattened into one buffer.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_JAGGED_VECTOR_HPP
+#define SEMISTABLE_JAGGED_VECTOR_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <semistable/vector.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace semistable {
+
+/* jagged_vector stores a sequence of rows of elements in a single
+ * semistable::vector, one row after another, plus the offsets where each
+ * row begins. Inserting into or erasing from a row shifts the elements of
+ * the rows after it under the one epoch chain of the underlying vector, so
+ * iterators into any row stay valid, and traversing all the elements is a
+ * single linear scan. Row modifications also update the offsets of the
+ * rows after it, which is a linear (but cache-friendly) pass over the
+ * offsets. Row numbers are not stable: erasing a row renumbers the rows
+ * after it.
+ */
+
+template<typename T, typename Allocator = std::allocator<T>>
+class jagged_vector
+{
+  using vector_type = semistable::vector<T, Allocator>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+  /* types */
+
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = typename vector_type::size_type;
+  using difference_type = typename vector_type::difference_type;
+  using iterator = typename vector_type::iterator;
+  using const_iterator = typename vector_type::const_iterator;
+
+  /* Plain view of a row, invalidated by any modification (use row_begin()
+   * and row_end() for stable iterators).
+   */
+
+  template<typename Q>
+  struct basic_row_view
+  {
+    Q*        begin() const noexcept { return first; }
+    Q*        end() const noexcept { return first + n; }
+    size_type size() const noexcept { return n; }
+    bool      empty() const noexcept { return n == 0; }
+    Q&        operator[](size_type i) const noexcept { return first[i]; }
+
+    Q*        first;
+    size_type n;
+  };
+
+  using row_view = basic_row_view<T>;
+  using const_row_view = basic_row_view<const T>;
+
+  /* construct/copy/destroy */
+
+  jagged_vector(): jagged_vector{Allocator()} {}
+
+  explicit jagged_vector(const Allocator& al):
+    vec{al}, offsets(1, 0, offset_allocator{al}) {}
+
+  jagged_vector(const jagged_vector&) = default;
+
+  /* moved-from jagged_vectors are left with no rows */
+
+  jagged_vector(jagged_vector&& x):
+    jagged_vector{
+      std::move(x), offset_vector(1, 0, x.offsets.get_allocator())} {}
+
+  jagged_vector& operator=(const jagged_vector&) = default;
+
+  jagged_vector& operator=(jagged_vector&& x)
+  {
+    if(this != &x) {
+      offset_vector offsets_for_x(1, 0, x.offsets.get_allocator());
+      vec = std::move(x.vec);
+      offsets = std::move(x.offsets);
+      if(!x.vec.empty()) x.vec.clear(); /* unequal allocators */
+      x.offsets.swap(offsets_for_x);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return vec.get_allocator(); }
+
+  /* the elements of all rows, one row after another */
+
+  const vector_type& values() const noexcept { return vec; }
+
+  /* iterators over all the elements */
+
+  iterator       begin() noexcept { return vec.begin(); }
+  const_iterator begin() const noexcept { return vec.begin(); }
+  iterator       end() noexcept { return vec.end(); }
+  const_iterator end() const noexcept { return vec.end(); }
+  const_iterator cbegin() const noexcept { return vec.cbegin(); }
+  const_iterator cend() const noexcept { return vec.cend(); }
+
+  /* capacity */
+
+  bool      empty() const noexcept { return vec.empty(); }
+  size_type size() const noexcept { return vec.size(); }
+  size_type rows() const noexcept { return offsets.size() - 1; }
+
+  void reserve(size_type num_elements, size_type num_rows = 0)
+  {
+    vec.reserve(num_elements);
+    offsets.reserve(num_rows + 1);
+  }
+
+  void shrink_to_fit()
+  {
+    vec.shrink_to_fit();
+    offsets.shrink_to_fit();
+  }
+
+  /* row access */
+
+  size_type row_size(size_type r) const noexcept
+  {
+    return offsets[r + 1] - offsets[r];
+  }
+
+  iterator row_begin(size_type r) noexcept
+  {
+    return vec.begin() + (difference_type)offsets[r];
+  }
+
+  const_iterator row_begin(size_type r) const noexcept
+  {
+    return vec.cbegin() + (difference_type)offsets[r];
+  }
+
+  iterator row_end(size_type r) noexcept
+  {
+    return vec.begin() + (difference_type)offsets[r + 1];
+  }
+
+  const_iterator row_end(size_type r) const noexcept
+  {
+    return vec.cbegin() + (difference_type)offsets[r + 1];
+  }
+
+  row_view row(size_type r) noexcept
+  {
+    return {vec.data() + offsets[r], row_size(r)};
+  }
+
+  const_row_view row(size_type r) const noexcept
+  {
+    return {vec.data() + offsets[r], row_size(r)};
+  }
+
+  row_view operator[](size_type r) noexcept { return row(r); }
+  const_row_view operator[](size_type r) const noexcept { return row(r); }
+
+  /* row modifiers */
+
+  void push_row() { offsets.push_back(offsets.back()); }
+
+  template<
+    typename InputIterator,
+    typename = typename std::enable_if<
+      std::is_convertible<
+        typename std::iterator_traits<InputIterator>::iterator_category,
+        std::input_iterator_tag
+      >::value
+    >::type
+  >
+  void push_row(InputIterator first, InputIterator last)
+  {
+    /* geometric growth, as reserving just one more slot would reallocate
+     * offsets on every call
+     */
+
+    if(offsets.size() == offsets.capacity()) {
+      offsets.reserve(2 * offsets.capacity());
+    }
+    vec.insert(vec.end(), first, last);
+    offsets.push_back(vec.size()); /* can't throw after reserve */
+  }
+
+  void push_row(std::initializer_list<T> il)
+  {
+    push_row(il.begin(), il.end());
+  }
+
+  /* rows after r are renumbered */
+
+  void erase_row(size_type r)
+  {
+    auto n = row_size(r);
+    vec.erase(row_begin(r), row_end(r));
+    offsets.erase(offsets.begin() + (difference_type)r + 1);
+    shift_offsets(r + 1, -(difference_type)n);
+  }
+
+  void pop_row() { erase_row(rows() - 1); }
+
+  /* element modifiers: pos must be in [row_begin(r), row_end(r)] */
+
+  template<typename... Args>
+  iterator emplace(size_type r, const_iterator pos, Args&&... args)
+  {
+    auto res = vec.emplace(pos, std::forward<Args>(args)...);
+    shift_offsets(r + 1, 1);
+    return res;
+  }
+
+  iterator insert(size_type r, const_iterator pos, const T& x)
+  {
+    return emplace(r, pos, x);
+  }
+
+  iterator insert(size_type r, const_iterator pos, T&& x)
+  {
+    return emplace(r, pos, std::move(x));
+  }
+
+  iterator insert(size_type r, const_iterator pos, size_type n, const T& x)
+  {
+    auto res = vec.insert(pos, n, x);
+    shift_offsets(r + 1, (difference_type)n);
+    return res;
+  }
+
+  template<
+    typename InputIterator,
+    typename = typename std::enable_if<
+      std::is_convertible<
+        typename std::iterator_traits<InputIterator>::iterator_category,
+        std::input_iterator_tag
+      >::value
+    >::type
+  >
+  iterator insert(
+    size_type r, const_iterator pos, InputIterator first, InputIterator last)
+  {
+    auto n = vec.size();
+    auto res = vec.insert(pos, first, last);
+    shift_offsets(r + 1, (difference_type)(vec.size() - n));
+    return res;
+  }
+
+  template<typename... Args>
+  reference emplace_back(size_type r, Args&&... args)
+  {
+    return *emplace(r, row_end(r), std::forward<Args>(args)...);
+  }
+
+  void push_back(size_type r, const T& x) { emplace_back(r, x); }
+  void push_back(size_type r, T&& x) { emplace_back(r, std::move(x)); }
+
+  iterator erase(size_type r, const_iterator pos)
+  {
+    return erase(r, pos, pos + 1);
+  }
+
+  iterator erase(size_type r, const_iterator first, const_iterator last)
+  {
+    auto n = last - first;
+    auto res = vec.erase(first, last);
+    shift_offsets(r + 1, -n);
+    return res;
+  }
+
+  void swap(jagged_vector& x)
+  {
+    vec.swap(x.vec);
+    offsets.swap(x.offsets);
+  }
+
+  void clear()
+  {
+    vec.clear();
+    offsets.resize(1);
+  }
+
+private:
+  using offset_allocator =
+    typename alloc_traits::template rebind_alloc<size_type>;
+  using offset_vector = std::vector<size_type, offset_allocator>;
+
+  jagged_vector(jagged_vector&& x, offset_vector&& offsets_for_x):
+    vec{std::move(x.vec)}, offsets{std::move(x.offsets)}
+  {
+    x.offsets.swap(offsets_for_x);
+  }
+
+  void shift_offsets(size_type r, difference_type n) noexcept
+  {
+    for(auto first = offsets.begin() + (difference_type)r,
+             last = offsets.end(); first != last; ++first) {
+      *first += (size_type)n;
+    }
+  }
+
+  vector_type   vec;
+  offset_vector offsets; /* rows() + 1 entries */
+};
+
+template<typename T, typename Allocator>
+bool operator==(
+  const jagged_vector<T, Allocator>& x, const jagged_vector<T, Allocator>& y)
+{
+  if(x.rows() != y.rows()) return false;
+  for(std::size_t r = 0; r < x.rows(); ++r) {
+    if(x.row_size(r) != y.row_size(r)) return false;
+  }
+  return x.values() == y.values();
+}
+
+template<typename T, typename Allocator>
+bool operator!=(
+  const jagged_vector<T, Allocator>& x, const jagged_vector<T, Allocator>& y)
+{
+  return !(x == y);
+}
+
+template<typename T, typename Allocator>
+void swap(jagged_vector<T, Allocator>& x, jagged_vector<T, Allocator>& y)
+{
+  x.swap(y);
+}
+
+} /* namespace semistable */
+
+#endif
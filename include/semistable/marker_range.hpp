@@ -0,0 +1,154 @@
+/* Range markers for semistable::vector.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_MARKER_RANGE_HPP
+#define SEMISTABLE_MARKER_RANGE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <semistable/vector.hpp>
+#include <type_traits>
+
+namespace semistable {
+
+/* Which way an end of a marker_range goes when elements are inserted right
+ * at it:
+ *   - left: the end stays before the inserted elements,
+ *   - right: the end moves past the inserted elements.
+ */
+
+enum class gravity
+{
+  left,
+  right
+};
+
+/* marker_range tracks a range of positions [first, last) of a
+ * semistable::vector through insertions and erasures: elements inserted
+ * inside the range grow it, erasing elements of the range shrinks it (down
+ * to an empty range at the point of erasure), and insertions right at
+ * either end extend the range or not according to the gravity of the end
+ * (by default the range grows on both ends). As with iterators, the range
+ * is brought up to date lazily when accessed, follows its elements on swap
+ * and move construction, and can't be used concurrently with modifications
+ * of the vector.
+ */
+
+template<
+  typename T,
+  typename Allocator = std::allocator<typename std::remove_const<T>::type>
+>
+class marker_range
+{
+  using epoch_pointer = detail::epoch_pointer<
+    detail::epoch_allocator<Allocator>>;
+
+public:
+  using value_type = typename std::remove_const<T>::type;
+  using size_type = std::size_t;
+  using pointer = T*;
+  using iterator = T*;
+
+  marker_range(
+    vector<value_type, Allocator>& x, size_type first_, size_type last_,
+    gravity first_gravity = gravity::left,
+    gravity last_gravity = gravity::right):
+    marker_range{
+      detail::access::get_epoch(x), first_, last_,
+      first_gravity, last_gravity} {}
+
+  template<
+    typename Q = T,
+    typename = typename std::enable_if<std::is_const<Q>::value>::type
+  >
+  marker_range(
+    const vector<value_type, Allocator>& x, size_type first_, size_type last_,
+    gravity first_gravity = gravity::left,
+    gravity last_gravity = gravity::right):
+    marker_range{
+      detail::access::get_epoch(x), first_, last_,
+      first_gravity, last_gravity} {}
+
+  size_type first() const noexcept
+  {
+    update();
+    return pos_first;
+  }
+
+  size_type last() const noexcept
+  {
+    update();
+    return pos_last;
+  }
+
+  size_type size() const noexcept
+  {
+    update();
+    return pos_last - pos_first;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  /* the elements currently in the range */
+
+  pointer begin() const noexcept
+  {
+    update();
+    return detail::data_cast<T>(pe->data) + pos_first;
+  }
+
+  pointer end() const noexcept
+  {
+    update();
+    return detail::data_cast<T>(pe->data) + pos_last;
+  }
+
+  gravity first_gravity() const noexcept { return grav_first; }
+  gravity last_gravity() const noexcept { return grav_last; }
+
+  /* Splits the range in halves: *this keeps the first one and the second
+   * one is returned. Elements inserted right at the split point go to the
+   * second half.
+   */
+
+  marker_range split() noexcept
+  {
+    update();
+    auto         mid = pos_first + (pos_last - pos_first) / 2;
+    marker_range res{pe, mid, pos_last, gravity::left, grav_last};
+    pos_last = mid;
+    grav_last = gravity::left;
+    return res;
+  }
+
+private:
+  marker_range(
+    const epoch_pointer& pe_, size_type first_, size_type last_,
+    gravity first_gravity, gravity last_gravity):
+    pe{pe_}, pos_first{first_}, pos_last{last_},
+    grav_first{first_gravity}, grav_last{last_gravity} {}
+
+  void update() const noexcept
+  {
+    if(BOOST_UNLIKELY(pe->next.get() != nullptr)) {
+      auto r = detail::catch_up_range(
+        pe, pos_first, pos_last,
+        grav_first == gravity::right, grav_last == gravity::right);
+      pos_first = r.first;
+      pos_last = r.second;
+    }
+  }
+
+  mutable epoch_pointer pe;
+  mutable size_type     pos_first, pos_last;
+  gravity               grav_first, grav_last;
+};
+
+} /* namespace semistable */
+
+#endif
@@ -0,0 +1,93 @@
+/* Execution-policy-aware assignment for semistable::vector.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_PARALLEL_HPP
+#define SEMISTABLE_PARALLEL_HPP
+
+#include <boost/config.hpp>
+#include <semistable/vector.hpp>
+
+#if defined(BOOST_NO_CXX17_HDR_EXECUTION) || BOOST_CXX_VERSION < 201703L
+#define SEMISTABLE_NO_CXX17_HDR_EXECUTION
+#endif
+
+#if !defined(SEMISTABLE_NO_CXX17_HDR_EXECUTION)
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace semistable {
+
+/* Assigns [first, last) to x by copying over x's existing elements with the
+ * given standard execution policy and then appending the remaining elements
+ * or erasing the excess ones, which publishes at most one epoch. Copying into
+ * a vector already holding as many elements as the source (e.g. when the same
+ * vector is refreshed over and over) thus scales with the threads used by the
+ * policy. Otherwise, and also when the new contents don't fit into x's
+ * capacity, the tail of the copy is done sequentially. As with standard
+ * parallel algorithms, an exception thrown by copying elements calls
+ * std::terminate, and x iterators must not be passed as first and last
+ * (concurrently copying them is not thread safe): use their raw() pointers
+ * instead.
+ */
+
+template<
+  typename ExecutionPolicy, typename T, typename Allocator,
+  typename ForwardIterator,
+  typename = typename std::enable_if<
+    std::is_execution_policy<
+      typename std::remove_cv<
+        typename std::remove_reference<ExecutionPolicy>::type>::type
+    >::value
+  >::type
+>
+void assign(
+  ExecutionPolicy&& policy, vector<T, Allocator>& x,
+  ForwardIterator first, ForwardIterator last)
+{
+  using size_type = typename vector<T, Allocator>::size_type;
+  using difference_type = typename vector<T, Allocator>::difference_type;
+
+  auto n = (size_type)std::distance(first, last);
+  if(n > x.capacity()) {
+    x.assign(first, last);
+    return;
+  }
+
+  auto m = (std::min)(n, x.size());
+  auto mid = std::next(first, (difference_type)m);
+  std::copy(std::forward<ExecutionPolicy>(policy), first, mid, x.data());
+  if(n > m) x.insert(x.end(), mid, last);
+  else if(m < x.size()) x.erase(x.begin() + (difference_type)m, x.end());
+}
+
+template<
+  typename ExecutionPolicy, typename T, typename Allocator,
+  typename = typename std::enable_if<
+    std::is_execution_policy<
+      typename std::remove_cv<
+        typename std::remove_reference<ExecutionPolicy>::type>::type
+    >::value
+  >::type
+>
+void assign(
+  ExecutionPolicy&& policy, vector<T, Allocator>& x,
+  const vector<T, Allocator>& y)
+{
+  if(&x == &y) return;
+  assign(
+    std::forward<ExecutionPolicy>(policy), x, y.data(), y.data() + y.size());
+}
+
+} /* namespace semistable */
+
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+/* Resumable scan cursor for semistable::vector.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_SCAN_CURSOR_HPP
+#define SEMISTABLE_SCAN_CURSOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <semistable/vector.hpp>
+#include <type_traits>
+
+namespace semistable {
+
+/* Which elements inserted during a scan get visited:
+ *   - those inserted ahead of the cursor (including right at it) and before
+ *     the scan bound are always visited, those inserted behind the cursor
+ *     are never visited,
+ *   - include_appended: the bound is the end of the vector, so elements
+ *     appended during the scan are visited,
+ *   - exclude_appended: the bound is the end of the vector as of the start
+ *     of the scan, so elements inserted at or after it are not visited.
+ */
+
+enum class scan_policy
+{
+  include_appended,
+  exclude_appended
+};
+
+/* scan_cursor visits the elements of a semistable::vector in budgeted slices
+ * while the vector is being modified in between (or by the visitation
+ * function itself). Elements present for the whole scan are visited exactly
+ * once, and no element is visited more than once. Like iterators, the cursor
+ * is attached to the epoch chain of the vector, so it follows its elements
+ * on swap and move construction, and can't be used concurrently with
+ * modifications of the vector.
+ */
+
+template<
+  typename T,
+  typename Allocator = std::allocator<typename std::remove_const<T>::type>
+>
+class scan_cursor
+{
+  using epoch_pointer = detail::epoch_pointer<
+    detail::epoch_allocator<Allocator>>;
+
+public:
+  using value_type = typename std::remove_const<T>::type;
+  using size_type = std::size_t;
+  using reference = T&;
+
+  explicit scan_cursor(
+    vector<value_type, Allocator>& x,
+    scan_policy policy_ = scan_policy::include_appended):
+    scan_cursor{detail::access::get_epoch(x), x.size(), policy_} {}
+
+  template<
+    typename Q = T,
+    typename = typename std::enable_if<std::is_const<Q>::value>::type
+  >
+  explicit scan_cursor(
+    const vector<value_type, Allocator>& x,
+    scan_policy policy_ = scan_policy::include_appended):
+    scan_cursor{detail::access::get_epoch(x), x.size(), policy_} {}
+
+  /* Visits up to budget elements with f and returns the number of elements
+   * visited.
+   */
+
+  template<typename F>
+  size_type scan(size_type budget, F f)
+  {
+    size_type n = 0;
+    for(; n < budget; ++n) {
+      update();
+      if(pos >= last) break;
+      f(detail::data_cast<T>(pe->data)[pos++]);
+    }
+    return n;
+  }
+
+  bool done() const noexcept
+  {
+    update();
+    return pos >= last;
+  }
+
+  /* index of the next element to visit */
+
+  size_type position() const noexcept
+  {
+    update();
+    return pos;
+  }
+
+  size_type remaining() const noexcept
+  {
+    update();
+    return last - pos;
+  }
+
+  scan_policy policy() const noexcept { return pol; }
+
+private:
+  scan_cursor(const epoch_pointer& pe_, size_type n, scan_policy policy_):
+    pe{pe_}, pos{0}, last{n}, pol{policy_} {}
+
+  void update() const noexcept
+  {
+    if(BOOST_UNLIKELY(pe->next.get() != nullptr)) {
+      /* pos never passes last, as it doesn't advance on insertion */
+
+      auto r = detail::catch_up_range(
+        pe, pos, last, false, pol == scan_policy::include_appended);
+      pos = r.first;
+      last = r.second;
+    }
+  }
+
+  mutable epoch_pointer pe;
+  mutable size_type     pos, last;
+  scan_policy           pol;
+};
+
+} /* namespace semistable */
+
+#endif
@@ -0,0 +1,1049 @@
+/* Fixed-capacity semistable vector with inline storage.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_STATIC_VECTOR_HPP
+#define SEMISTABLE_STATIC_VECTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <semistable/vector.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace semistable {
+
+template<typename T, std::size_t N, std::size_t NumEpochs = 16>
+class static_vector;
+
+namespace detail {
+
+/* Inline pool of NumEpochs epoch nodes replacing the heap-allocated epoch
+ * chain of semistable::vector. Nodes are linked by index and reference
+ * counted by links from their predecessor and by the pool itself for the
+ * head and the three prior epochs. Iterators hold no counts, as they can
+ * outlive the container and then must not touch the pool on assignment or
+ * destruction: instead, a node is pinned when an iterator gets to it, and
+ * pinned nodes are neither reused nor fused, and kept in the chain after
+ * losing their counts. Otherwise, nodes are reused and fused exactly as
+ * semistable::vector does. When all nodes are in use, the oldest one in the
+ * chain is forcibly recycled: its generation number is bumped so that
+ * iterators still there detect they are stale.
+ */
+
+template<std::size_t NumEpochs>
+struct epoch_pool
+{
+  using gen_type = unsigned long long;
+
+  static constexpr std::size_t none = NumEpochs;
+
+  struct node: epoch_shift
+  {
+    std::size_t       next = none;
+    gen_type          gen = 0;
+    long              refs = 0;
+    std::atomic<bool> pinned{false}; /* iterators may pin concurrently */
+  };
+
+  epoch_pool() noexcept
+  {
+    nodes[head].refs = 1;
+  }
+
+  epoch_pool(const epoch_pool&) = delete;
+  epoch_pool& operator=(const epoch_pool&) = delete;
+
+  bool stale(std::size_t n, gen_type gen) const noexcept
+  {
+    return nodes[n].gen != gen;
+  }
+
+  void pin(std::size_t n) noexcept
+  {
+    if(!pinned(n)) nodes[n].pinned.store(true, std::memory_order_relaxed);
+  }
+
+  bool pinned(std::size_t n) const noexcept
+  {
+    return nodes[n].pinned.load(std::memory_order_relaxed);
+  }
+
+  void acquire(std::size_t n) noexcept
+  {
+    if(n != none) ++nodes[n].refs;
+  }
+
+  void release(std::size_t n) noexcept
+  {
+    /* non-recursive, as epoch_node's destructor */
+
+    while(n != none && --nodes[n].refs == 0 && !pinned(n)) {
+      auto next = nodes[n].next;
+      nodes[n].next = none;
+      n = next;
+    }
+  }
+
+  void push(const epoch_shift& e) noexcept
+  {
+    auto n = make_node();
+    auto& x = nodes[n];
+    release(x.next);
+    static_cast<epoch_shift&>(x) = e;
+    x.next = none;
+    nodes[head].next = n;
+    acquire(n);
+    release(pe3);
+    pe3 = pe2;
+    pe2 = pe1;
+    pe1 = head;
+    head = n;
+  }
+
+  std::size_t make_node() noexcept
+  {
+    /* only held by the pool, i.e. not linked from an older epoch */
+
+    auto spare = [this] (std::size_t n) {
+      return n != none && nodes[n].refs == 1 && !pinned(n);
+    };
+
+    if(spare(pe3)) return take(pe3);
+    else if(spare(pe2)) return take(pe2);
+    else if(spare(pe1)) return take(pe1);
+    else if(pe2 != none && pe1 != none && !pinned(pe2) && !pinned(pe1) &&
+            nodes[pe2].try_fuse(nodes[pe1])) {
+      /* see semistable::vector::make_epoch_pointer */
+
+      nodes[pe2].next = nodes[pe1].next;
+      nodes[pe1].next = none;
+      --nodes[pe1].refs;
+      auto n = pe1;
+      pe1 = pe2;
+      pe2 = pe3;
+      pe3 = none;
+      return n;
+    }
+    for(std::size_t n = 0; n < NumEpochs; ++n) {
+      if(nodes[n].refs == 0 && !pinned(n)) {
+        nodes[n].refs = 1;
+        return n;
+      }
+    }
+    return recycle();
+  }
+
+  std::size_t take(std::size_t& n) noexcept
+  {
+    auto res = n;
+    n = none;
+    return res;
+  }
+
+  std::size_t recycle() noexcept
+  {
+    /* the oldest node is the only one in use not linked from another */
+
+    bool linked[NumEpochs] = {};
+    for(std::size_t n = 0; n < NumEpochs; ++n) {
+      if(nodes[n].next != none) linked[nodes[n].next] = true;
+    }
+    std::size_t n = 0;
+    while(linked[n]) ++n;
+
+    auto& x = nodes[n];
+    ++x.gen;
+    x.refs = 1;
+    x.pinned.store(false, std::memory_order_relaxed);
+    if(pe1 == n) pe1 = none;
+    else if(pe2 == n) pe2 = none;
+    else if(pe3 == n) pe3 = none;
+    return n;
+  }
+
+#if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
+  bool check_invariant() const noexcept
+  {
+    return
+      head != none && nodes[head].next == none &&
+      (pe1 == none || nodes[pe1].next == head) &&
+      (pe2 == none || (pe1 != none && nodes[pe2].next == pe1)) &&
+      (pe3 == none || (pe2 != none && nodes[pe3].next == pe2));
+  }
+#endif
+
+  node        nodes[NumEpochs];
+  std::size_t head = 0,
+              pe1 = none, pe2 = none, pe3 = none; /* three epochs prior */
+};
+
+template<typename T, std::size_t NumEpochs>
+class static_iterator
+{
+  using pool_type = epoch_pool<NumEpochs>;
+  using gen_type = typename pool_type::gen_type;
+  template<typename Q>
+  using enable_if_consts_to_value_type_t =
+    typename std::enable_if<std::is_same<const Q, T>::value>::type;
+
+public:
+  using value_type = typename std::remove_const<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+#if !defined(BOOST_NO_CXX20_HDR_CONCEPTS)
+  using iterator_category = std::contiguous_iterator_tag;
+#else
+  using iterator_category = std::random_access_iterator_tag;
+#endif
+
+  static_iterator() noexcept:
+    data{nullptr}, idx{0}, pp{nullptr}, n{0}, gen{0} {}
+
+  /* Copying, assignment and destruction don't touch the epoch pool, so
+   * that they're valid on iterators outliving their container.
+   */
+
+  static_iterator(const static_iterator&) = default;
+
+  template<
+    typename Q,
+    typename = enable_if_consts_to_value_type_t<Q>
+  >
+  static_iterator(const static_iterator<Q, NumEpochs>& x) noexcept:
+    data{x.data}, idx{x.idx}, pp{x.pp}, n{x.n}, gen{x.gen} {}
+
+  static_iterator& operator=(const static_iterator&) = default;
+
+  template<
+    typename Q,
+    typename = enable_if_consts_to_value_type_t<Q>
+  >
+  static_iterator& operator=(const static_iterator<Q, NumEpochs>& x) noexcept
+  {
+    data = x.data;
+    idx = x.idx;
+    pp = x.pp;
+    n = x.n;
+    gen = x.gen;
+    return *this;
+  }
+
+  /* The epoch of the iterator was recycled because the container ran out
+   * of epochs, so it can't follow its element any longer: the only valid
+   * operations on a stale iterator are stale(), copying, assignment and
+   * destruction.
+   */
+
+  bool stale() const noexcept { return pp && pp->stale(n, gen); }
+
+  pointer raw() const noexcept
+  {
+    update();
+    return data + idx;
+  }
+
+  pointer operator->() const noexcept
+  {
+    return raw();
+  }
+
+  reference operator*() const noexcept
+  {
+    return *raw();
+  }
+
+  static_iterator& operator++() noexcept
+  {
+    ++index();
+    return *this;
+  }
+
+  static_iterator operator++(int) noexcept
+  {
+    static_iterator tmp(*this);
+    ++index();
+    return tmp;
+  }
+
+  static_iterator& operator--() noexcept
+  {
+    --index();
+    return *this;
+  }
+
+  static_iterator operator--(int) noexcept
+  {
+    static_iterator tmp(*this);
+    --index();
+    return tmp;
+  }
+
+  friend difference_type
+  operator-(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return (difference_type)(x.index() - y.index());
+  }
+
+  static_iterator& operator+=(difference_type n) noexcept
+  {
+    index() += n;
+    return *this;
+  }
+
+  friend static_iterator
+  operator+(const static_iterator& x, difference_type n) noexcept
+  {
+    return {x.data, x.index() + n, x.pp};
+  }
+
+  friend static_iterator
+  operator+(difference_type n, const static_iterator& x) noexcept
+  {
+    return {x.data, n + x.index(), x.pp};
+  }
+
+  static_iterator& operator-=(difference_type n) noexcept
+  {
+    index() -= n;
+    return *this;
+  }
+
+  friend static_iterator
+  operator-(const static_iterator& x, difference_type n) noexcept
+  {
+    return {x.data, x.index() - n, x.pp};
+  }
+
+  reference operator[](difference_type n) const noexcept
+  {
+    return raw()[n];
+  }
+
+  friend bool
+  operator==(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return x.index() == y.index();
+  }
+
+  friend bool
+  operator!=(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return x.index() != y.index();
+  }
+
+  friend bool
+  operator<(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return x.index() < y.index();
+  }
+
+  friend bool
+  operator>(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return x.index() > y.index();
+  }
+
+  friend bool
+  operator<=(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return x.index() <= y.index();
+  }
+
+  friend bool
+  operator>=(const static_iterator& x, const static_iterator& y) noexcept
+  {
+    return x.index() >= y.index();
+  }
+
+private:
+  template<typename, std::size_t> friend class static_iterator;
+  template<typename, std::size_t, std::size_t>
+  friend class semistable::static_vector;
+
+  static_iterator(T* data_, std::size_t idx_, pool_type* pp_) noexcept:
+    data{data_}, idx{idx_}, pp{pp_}, n{pp_->head}, gen{pp_->nodes[n].gen}
+  {
+    pp->pin(n);
+  }
+
+  void update() const noexcept
+  {
+    auto m = pp->nodes[n].next;
+    if(BOOST_UNLIKELY(m != pool_type::none) && !pp->stale(n, gen)) {
+      std::size_t i = idx;
+      for(;;) {
+        const auto& e = pp->nodes[m];
+        if(i >= e.index) i += e.offset;
+        if(e.next == pool_type::none) break;
+        m = e.next;
+      }
+      idx = i;
+      pp->pin(m);
+      n = m;
+      gen = pp->nodes[m].gen;
+    }
+  }
+
+  std::size_t& index() const noexcept
+  {
+    update();
+    return idx;
+  }
+
+  T*                  data;
+  mutable std::size_t idx;
+  pool_type*          pp;
+  mutable std::size_t n;
+  mutable gen_type    gen;
+};
+
+} /* namespace detail */
+
+template<typename T, std::size_t N, std::size_t E, typename Predicate>
+typename static_vector<T, N, E>::size_type
+erase_if(static_vector<T, N, E>& x, Predicate pred);
+
+/* Semistable vector of capacity N with elements stored inline and epochs
+ * taken from an inline pool of NumEpochs nodes rather than from the heap, so
+ * no memory is ever allocated. Exceeding the capacity throws std::bad_alloc.
+ * Iterators keep following their elements as long as the epochs they lag
+ * behind fit in the pool (as with semistable::vector, consecutive epochs
+ * no iterator has been at get fused); otherwise they become stale().
+ * As elements are not relocatable as a whole, iterators stay with their
+ * container on move and swap.
+ */
+
+template<typename T, std::size_t N, std::size_t NumEpochs>
+class static_vector
+{
+  using pool_type = detail::epoch_pool<NumEpochs>;
+  using epoch_type = detail::epoch_shift;
+
+  static_assert(
+    !std::is_const<T>::value && !std::is_volatile<T>::value &&
+    !std::is_function<T>::value && !std::is_reference<T>::value &&
+    !std::is_void<T>::value,
+    "T must be a cv-unqualified object type");
+  static_assert(NumEpochs >= 2, "NumEpochs must be at least 2");
+
+public:
+  /* types */
+
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::static_iterator<T, NumEpochs>;
+  using const_iterator = detail::static_iterator<const T, NumEpochs>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+#if !defined(BOOST_NO_CXX20_HDR_CONCEPTS)
+  static_assert(std::contiguous_iterator<iterator>);
+  static_assert(std::contiguous_iterator<const_iterator>);
+#endif
+
+  /* construct/copy/destroy */
+
+  static_vector() noexcept {}
+
+  explicit static_vector(size_type n)
+  {
+    check_capacity(n);
+    append(n);
+  }
+
+  static_vector(size_type n, const T& value)
+  {
+    check_capacity(n);
+    append(n, value);
+  }
+
+  template<
+    typename InputIterator,
+    typename = typename std::enable_if<
+      std::is_convertible<
+        typename std::iterator_traits<InputIterator>::iterator_category,
+        std::input_iterator_tag
+      >::value
+    >::type
+  >
+  static_vector(InputIterator first, InputIterator last)
+  {
+    append(first, last);
+  }
+
+  static_vector(const static_vector& x)
+  {
+    append(x.data(), x.data() + x.size());
+  }
+
+  static_vector(static_vector&& x)
+    noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    append(
+      std::make_move_iterator(x.data()),
+      std::make_move_iterator(x.data() + x.size()));
+  }
+
+  static_vector(std::initializer_list<T> il)
+  {
+    append(il.begin(), il.end());
+  }
+
+  ~static_vector() { destroy_back(0); }
+
+  static_vector& operator=(const static_vector& x)
+  {
+    if(this != &x) assign(x.data(), x.data() + x.size());
+    return *this;
+  }
+
+  static_vector& operator=(static_vector&& x)
+  {
+    if(this != &x) {
+      assign(
+        std::make_move_iterator(x.data()),
+        std::make_move_iterator(x.data() + x.size()));
+    }
+    return *this;
+  }
+
+  static_vector& operator=(std::initializer_list<T> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+  template<
+    typename InputIterator,
+    typename = typename std::enable_if<
+      std::is_convertible<
+        typename std::iterator_traits<InputIterator>::iterator_category,
+        std::input_iterator_tag
+      >::value
+    >::type
+  >
+  void assign(InputIterator first, InputIterator last)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    new_epoch([&, this] {
+      auto n = sz;
+      assign_impl(
+        first, last,
+        typename std::iterator_traits<InputIterator>::iterator_category{});
+      return epoch_type{n, (difference_type)(sz - n)};
+    });
+  }
+
+  void assign(size_type n, const T& value)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    check_capacity_for(n);
+    new_epoch([&, this] {
+      auto m = sz;
+      destroy_back(0);
+      append(n, value);
+      return epoch_type{m, (difference_type)(n - m)};
+    });
+  }
+
+  void assign(std::initializer_list<T> il)
+  {
+    assign(il.begin(), il.end());
+  }
+
+  /* iterators */
+
+  iterator               begin() noexcept { return {data(), 0, &pool}; }
+  const_iterator         begin() const noexcept { return {data(), 0, &pool}; }
+  iterator               end() noexcept { return {data(), sz, &pool}; }
+  const_iterator         end() const noexcept { return {data(), sz, &pool}; }
+  reverse_iterator       rbegin() noexcept { return reverse_iterator{end()}; }
+  const_reverse_iterator rbegin() const noexcept
+                         { return const_reverse_iterator{end()};}
+  reverse_iterator       rend() noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator rend() const noexcept
+                         { return const_reverse_iterator{begin()}; }
+
+  const_iterator         cbegin() const noexcept { return begin(); }
+  const_iterator         cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  /* capacity */
+
+  bool                        empty() const noexcept { return sz == 0; }
+  size_type                   size() const noexcept { return sz; }
+  static constexpr size_type  max_size() noexcept { return N; }
+  static constexpr size_type  capacity() noexcept { return N; }
+
+  void resize(size_type n)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    check_capacity_for(n);
+    new_epoch([&, this] {
+      auto m = sz;
+      if(n < m) destroy_back(n);
+      else append(n - m);
+      return epoch_type{m, (difference_type)(n - m)};
+    });
+  }
+
+  void resize(size_type n, const T& value)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    check_capacity_for(n);
+    new_epoch([&, this] {
+      auto m = sz;
+      if(n < m) destroy_back(n);
+      else append(n - m, value);
+      return epoch_type{m, (difference_type)(n - m)};
+    });
+  }
+
+  static void reserve(size_type n) { check_capacity_for(n); }
+  static void shrink_to_fit() noexcept {}
+
+  /* element access */
+
+  reference       operator[](size_type n) { return data()[n]; }
+  const_reference operator[](size_type n) const { return data()[n]; }
+
+  reference at(size_type n)
+  {
+    if(n >= sz) throw std::out_of_range("static_vector::at");
+    return data()[n];
+  }
+
+  const_reference at(size_type n) const
+  {
+    if(n >= sz) throw std::out_of_range("static_vector::at");
+    return data()[n];
+  }
+
+  reference       front() { return data()[0]; }
+  const_reference front() const { return data()[0]; }
+  reference       back() { return data()[sz - 1]; }
+  const_reference back() const { return data()[sz - 1]; }
+
+  /* data access */
+
+  T*       data() noexcept { return reinterpret_cast<T*>(storage); }
+  const T* data() const noexcept
+           { return reinterpret_cast<const T*>(storage); }
+
+  /* modifiers */
+
+  template<typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    new_epoch([&, this] {
+      auto n = sz;
+      check_capacity(1);
+      construct_back(std::forward<Args>(args)...);
+      return epoch_type{n, 1};
+    });
+    return back();
+  }
+
+  void push_back(const T& x) { emplace_back(x); }
+  void push_back(T&& x) { emplace_back(std::move(x)); }
+
+  /* no exception on full capacity, nullptr returned instead */
+
+  template<typename... Args>
+  pointer try_emplace_back(Args&&... args)
+  {
+    if(sz == N) return nullptr;
+    return std::addressof(emplace_back(std::forward<Args>(args)...));
+  }
+
+  pointer try_push_back(const T& x) { return try_emplace_back(x); }
+  pointer try_push_back(T&& x) { return try_emplace_back(std::move(x)); }
+
+  void pop_back()
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    new_epoch([this] {
+      auto n = sz;
+      destroy_back(n - 1);
+      return epoch_type{n, -1};
+    });
+  }
+
+  template<typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto index = pos.index();
+    new_epoch([&, this] {
+      check_capacity(1);
+      construct_back(std::forward<Args>(args)...);
+      std::rotate(data() + index, data() + sz - 1, data() + sz);
+      return epoch_type{index, 1};
+    });
+    return {data(), index, &pool};
+  }
+
+  iterator insert(const_iterator pos, const T& x)
+  {
+    return emplace(pos, x);
+  }
+
+  iterator insert(const_iterator pos, T&& x)
+  {
+    return emplace(pos, std::move(x));
+  }
+
+  iterator insert(const_iterator pos, size_type n, const T& x)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto index = pos.index();
+    new_epoch([&, this] {
+      auto m = sz;
+      check_capacity(n);
+      append(n, x);
+      std::rotate(data() + index, data() + m, data() + sz);
+      return epoch_type{index, (difference_type)n};
+    });
+    return {data(), index, &pool};
+  }
+
+  template<
+    typename InputIterator,
+    typename = typename std::enable_if<
+      std::is_convertible<
+        typename std::iterator_traits<InputIterator>::iterator_category,
+        std::input_iterator_tag
+      >::value
+    >::type
+  >
+  iterator insert(const_iterator pos, InputIterator first, InputIterator last)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto index = pos.index();
+    new_epoch([&, this] {
+      auto m = sz;
+      append(first, last);
+      std::rotate(data() + index, data() + m, data() + sz);
+      return epoch_type{index, (difference_type)(sz - m)};
+    });
+    return {data(), index, &pool};
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> il)
+  {
+    return insert(pos, il.begin(), il.end());
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto findex = first.index(),
+         lindex = last.index();
+    new_epoch([&, this] {
+      std::move(data() + lindex, data() + sz, data() + findex);
+      destroy_back(sz - (lindex - findex));
+      return epoch_type{lindex, (difference_type)(findex - lindex)};
+    });
+    return {data(), findex, &pool};
+  }
+
+  /* elements are swapped, iterators stay with their container */
+
+  void swap(static_vector& x)
+  {
+    SEMISTABLE_CHECK_INVARIANT_OF(*this);
+    SEMISTABLE_CHECK_INVARIANT_OF(x);
+    if(this == &x) return;
+    new_epoch([&, this] {
+      auto n = sz;
+      x.new_epoch([&, this] {
+        auto m = x.sz;
+        auto& y = sz <= x.sz? *this: x;
+        auto& z = sz <= x.sz? x: *this;
+        auto  k = y.sz;
+        std::swap_ranges(y.data(), y.data() + k, z.data());
+        y.append(
+          std::make_move_iterator(z.data() + k),
+          std::make_move_iterator(z.data() + z.sz));
+        z.destroy_back(k);
+        return epoch_type{m, (difference_type)(x.sz - m)};
+      });
+      return epoch_type{n, (difference_type)(sz - n)};
+    });
+  }
+
+  void clear() noexcept
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    new_epoch([this] {
+      auto n = sz;
+      destroy_back(0);
+      return epoch_type{n, -(difference_type)n};
+    });
+  }
+
+private:
+  friend struct detail::access;
+  template<typename U, std::size_t M, std::size_t E, typename P>
+  friend typename static_vector<U, M, E>::size_type
+  erase_if(static_vector<U, M, E>&, P);
+
+  static void check_capacity_for(size_type n)
+  {
+    if(n > N) throw std::bad_alloc();
+  }
+
+  void check_capacity(size_type n) const
+  {
+    if(n > N - sz) throw std::bad_alloc();
+  }
+
+  template<typename... Args>
+  void construct_back(Args&&... args)
+  {
+    ::new ((void*)(data() + sz)) T(std::forward<Args>(args)...);
+    ++sz;
+  }
+
+  void destroy_back(size_type n) noexcept
+  {
+    while(sz > n) data()[--sz].~T();
+  }
+
+  /* elements appended are destroyed if an exception is thrown */
+
+  struct append_guard
+  {
+    ~append_guard()
+    {
+      if(active) x.destroy_back(n);
+    }
+
+    static_vector& x;
+    size_type      n;
+    bool           active;
+  };
+
+  void append(size_type n)
+  {
+    append_guard g{*this, sz, true};
+    while(n--) construct_back();
+    g.active = false;
+  }
+
+  void append(size_type n, const T& value)
+  {
+    append_guard g{*this, sz, true};
+    while(n--) construct_back(value);
+    g.active = false;
+  }
+
+  template<typename InputIterator>
+  void append(InputIterator first, InputIterator last)
+  {
+    append_guard g{*this, sz, true};
+    for(; first != last; ++first) {
+      check_capacity(1);
+      construct_back(*first);
+    }
+    g.active = false;
+  }
+
+  template<typename InputIterator>
+  void assign_impl(
+    InputIterator first, InputIterator last, std::input_iterator_tag)
+  {
+    destroy_back(0);
+    append(first, last);
+  }
+
+  template<typename ForwardIterator>
+  void assign_impl(
+    ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+  {
+    check_capacity_for((size_type)std::distance(first, last));
+    assign_impl(first, last, std::input_iterator_tag{});
+  }
+
+  /* f modifies the elements and returns the epoch describing the change. If
+   * f throws after changing the size, iterators are kept within the
+   * elements as in semistable::vector.
+   */
+
+  template<typename F>
+  void new_epoch(F f)
+  {
+    epoch_transaction t{*this, sz, false};
+    t.commit(f());
+  }
+
+  struct epoch_transaction
+  {
+    ~epoch_transaction()
+    {
+      if(!committed && x.sz != size) {
+        x.pool.push(epoch_type{size, (difference_type)(x.sz - size)});
+      }
+    }
+
+    void commit(const epoch_type& e) noexcept
+    {
+      x.pool.push(e);
+      committed = true;
+    }
+
+    static_vector& x;
+    size_type      size;
+    bool           committed;
+  };
+
+#if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
+  bool check_invariant() const noexcept
+  {
+    return sz <= N && pool.check_invariant();
+  }
+#endif
+
+  alignas(T) unsigned char storage[sizeof(T) * (N? N: 1)];
+  size_type                sz = 0;
+  mutable pool_type        pool;
+};
+
+template<typename T, std::size_t N, std::size_t E>
+bool operator==(
+  const static_vector<T, N, E>& x, const static_vector<T, N, E>& y)
+{
+  return x.size() == y.size() &&
+         std::equal(x.data(), x.data() + x.size(), y.data());
+}
+
+template<typename T, std::size_t N, std::size_t E>
+bool operator!=(
+  const static_vector<T, N, E>& x, const static_vector<T, N, E>& y)
+{
+  return !(x == y);
+}
+
+template<typename T, std::size_t N, std::size_t E>
+bool operator<(
+  const static_vector<T, N, E>& x, const static_vector<T, N, E>& y)
+{
+  return std::lexicographical_compare(
+    x.data(), x.data() + x.size(), y.data(), y.data() + y.size());
+}
+
+template<typename T, std::size_t N, std::size_t E>
+bool operator<=(
+  const static_vector<T, N, E>& x, const static_vector<T, N, E>& y)
+{
+  return !(y < x);
+}
+
+template<typename T, std::size_t N, std::size_t E>
+bool operator>(
+  const static_vector<T, N, E>& x, const static_vector<T, N, E>& y)
+{
+  return y < x;
+}
+
+template<typename T, std::size_t N, std::size_t E>
+bool operator>=(
+  const static_vector<T, N, E>& x, const static_vector<T, N, E>& y)
+{
+  return !(x < y);
+}
+
+template<typename T, std::size_t N, std::size_t E>
+void swap(static_vector<T, N, E>& x, static_vector<T, N, E>& y)
+{
+  x.swap(y);
+}
+
+/* erasure */
+
+template<typename T, std::size_t N, std::size_t E, typename Predicate>
+typename static_vector<T, N, E>::size_type
+erase_if(static_vector<T, N, E>& x, Predicate pred)
+{
+  using size_type = typename static_vector<T, N, E>::size_type;
+  using difference_type = typename static_vector<T, N, E>::difference_type;
+
+  SEMISTABLE_CHECK_INVARIANT_OF(x);
+  T *first = x.data(), *last = x.data() + x.size();
+  while(first != last && !pred(*first)) ++first;
+
+  /* as in semistable::vector, a run of erased elements is published before
+   * compacting the elements after it, so the gap must be closed also if
+   * pred or an element move throws
+   */
+
+  T* gap_last = first;
+  struct gap_closer
+  {
+    ~gap_closer()
+    {
+      if(active) {
+        x.destroy_back(
+          (size_type)(std::move(gap_last, x.data() + x.sz, first) - x.data()));
+      }
+    }
+
+    static_vector<T, N, E>& x;
+    T*&                     first;
+    T*&                     gap_last;
+    bool                    active;
+  } g{x, first, gap_last, std::is_nothrow_move_assignable<T>::value};
+  if(first != last) {
+    auto it = first;
+    do {
+      auto            index = (size_type)(first - x.data());
+      difference_type offset = 1;
+      while(++it != last && pred(*it)) ++offset;
+      x.pool.push({index + offset, -offset});
+      gap_last = it;
+      while(it != last && !pred(*it)) {
+        *first++ = std::move(*it++);
+        gap_last = it;
+      }
+    } while(it != last);
+  }
+  g.active = false;
+  size_type s = x.sz;
+  x.destroy_back((size_type)(first - x.data()));
+  return s - x.sz;
+}
+
+template<typename T, std::size_t N, std::size_t E, typename U = T>
+typename static_vector<T, N, E>::size_type
+erase(static_vector<T, N, E>& x, const U& value)
+{
+  return erase_if(x, [&](const T& v) { return v == value; });
+}
+
+} /* namespace semistable */
+
+#endif
@@ -0,0 +1,135 @@
+/* Process-wide registry of containers to trim under memory pressure.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef SEMISTABLE_TRIM_HPP
+#define SEMISTABLE_TRIM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+
+namespace semistable {
+
+class trim_registration;
+
+namespace detail {
+
+/* Intrusive list of registrations with a round-robin cursor. The mutex is
+ * held while trimming, so a registration can't go away (along with its
+ * container, presumably) in the middle of it.
+ */
+
+struct trim_registry
+{
+  static trim_registry& instance()
+  {
+    static trim_registry r;
+    return r;
+  }
+
+  inline void        link(trim_registration* r);
+  inline void        unlink(trim_registration* r) noexcept;
+  inline std::size_t trim(std::size_t max_count);
+
+  std::mutex         mtx;
+  trim_registration* head = nullptr;
+  trim_registration* cursor = nullptr;
+  std::size_t        size = 0;
+};
+
+} /* namespace detail */
+
+/* Registers x, which can be any object with a trim() member function (such
+ * as semistable::vector), for as long as the registration lives.
+ */
+
+class trim_registration
+{
+public:
+  template<typename Trimmable>
+  explicit trim_registration(Trimmable& x):
+    obj{&x}, trim{&trim_object<Trimmable>}
+  {
+    detail::trim_registry::instance().link(this);
+  }
+
+  trim_registration(const trim_registration&) = delete;
+  trim_registration& operator=(const trim_registration&) = delete;
+
+  ~trim_registration()
+  {
+    detail::trim_registry::instance().unlink(this);
+  }
+
+private:
+  friend struct detail::trim_registry;
+
+  template<typename Trimmable>
+  static void trim_object(void* p) { static_cast<Trimmable*>(p)->trim(); }
+
+  void*              obj;
+  void             (*trim)(void*);
+  trim_registration* prev = nullptr;
+  trim_registration* next = nullptr;
+};
+
+namespace detail {
+
+void trim_registry::link(trim_registration* r)
+{
+  std::lock_guard<std::mutex> lck{mtx};
+  r->next = head;
+  if(head) head->prev = r;
+  head = r;
+  ++size;
+}
+
+void trim_registry::unlink(trim_registration* r) noexcept
+{
+  std::lock_guard<std::mutex> lck{mtx};
+  if(cursor == r) cursor = r->next;
+  if(r->prev) r->prev->next = r->next;
+  else head = r->next;
+  if(r->next) r->next->prev = r->prev;
+  --size;
+}
+
+std::size_t trim_registry::trim(std::size_t max_count)
+{
+  std::lock_guard<std::mutex> lck{mtx};
+  auto n = (std::min)(max_count, size);
+  for(std::size_t i = 0; i < n; ++i) {
+    if(!cursor) cursor = head;
+    auto r = cursor;
+    cursor = r->next;
+    r->trim(r->obj);
+  }
+  return n;
+}
+
+} /* namespace detail */
+
+/* Trims up to max_count registered objects, resuming where the previous
+ * call left off, and returns how many were trimmed: a memory-pressure
+ * handler can bound the time spent per call and still reach every object
+ * over successive calls. Registering and unregistering are thread-safe, but
+ * no other thread may be using the objects trimmed meanwhile. Epoch nodes
+ * cached by other threads (see SEMISTABLE_EPOCH_CACHE_SIZE) are released
+ * only when those threads trim a vector or exit.
+ */
+
+inline std::size_t trim_registered(
+  std::size_t max_count = (std::numeric_limits<std::size_t>::max)())
+{
+  return detail::trim_registry::instance().trim(max_count);
+}
+
+} /* namespace semistable */
+
+#endif
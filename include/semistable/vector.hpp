@@ -11,13 +11,23 @@
 
 #include <boost/config.hpp>
 #include <boost/config/workaround.hpp>
+#include <boost/core/empty_value.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined(BOOST_LIBSTDCXX_VERSION)
+#include <ext/atomicity.h>
+#endif
+
 #if !defined(BOOST_NO_CXX20_HDR_CONCEPTS)
 #include <concepts>
 #endif
@@ -48,6 +58,65 @@ is enabled in NDEBUG mode
 #endif
 #endif
 
+/* Number of epochs prior to the head remembered by a vector for reuse and
+ * fusion (see vector::make_epoch_pointer). A larger window lets epochs be
+ * recycled while a few iterators lag somewhat behind the head, at the
+ * expense of scanning the window on each modification.
+ */
+
+#if !defined(SEMISTABLE_EPOCH_LOOKBACK)
+#define SEMISTABLE_EPOCH_LOOKBACK 3
+#endif
+
+/* Maximum number of freed epoch nodes kept by each thread for reuse by any
+ * vector using std::allocator (see detail::epoch_cache). Define
+ * SEMISTABLE_NO_EPOCH_CACHE to allocate and free every node directly.
+ */
+
+#if !defined(SEMISTABLE_EPOCH_CACHE_SIZE)
+#define SEMISTABLE_EPOCH_CACHE_SIZE 64
+#endif
+
+/* Define SEMISTABLE_COMPACT_EPOCHS to record epoch shifts with 32-bit
+ * indices, which brings epoch nodes down from 64 to 48 bytes but limits
+ * max_size() to 2^31 - 1 elements (not supported by circular_buffer, whose
+ * sequence numbers grow unboundedly).
+ */
+
+#if defined(SEMISTABLE_NO_PREFETCH)
+#define SEMISTABLE_PREFETCH(p) ((void)(p))
+#elif defined(__GNUC__)
+#define SEMISTABLE_PREFETCH(p) __builtin_prefetch((const char*)(p))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define SEMISTABLE_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+#define SEMISTABLE_PREFETCH(p) ((void)(p))
+#endif
+
+/* Optional USDT probes (provider semistable) for observing epoch activity,
+ * e.g. with bpftrace:
+ *   - epoch_publish(index, offset): a modification publishes an epoch,
+ *   - epoch_reuse(depth), epoch_fuse(), epoch_allocate(): how the epoch was
+ *     obtained (reused from depth positions behind the head, freed up by
+ *     fusing two older epochs, or newly allocated),
+ *   - catch_up_begin(node), catch_up_end(node, steps): an iterator, cursor
+ *     etc. walks the chain from node to the head in steps hops,
+ *   - epoch_destroy(node): an epoch is freed.
+ */
+
+#if defined(SEMISTABLE_ENABLE_USDT)
+#include <sys/sdt.h>
+#define SEMISTABLE_PROBE(name) DTRACE_PROBE(semistable, name)
+#define SEMISTABLE_PROBE1(name, a1) DTRACE_PROBE1(semistable, name, a1)
+#define SEMISTABLE_PROBE2(name, a1, a2) \
+  DTRACE_PROBE2(semistable, name, a1, a2)
+#else
+#define SEMISTABLE_PROBE(name) ((void)0)
+#define SEMISTABLE_PROBE1(name, a1) ((void)0)
+#define SEMISTABLE_PROBE2(name, a1, a2) ((void)0)
+#endif
+
 namespace semistable {
 
 template<typename, typename> class vector;
@@ -55,52 +124,874 @@ template<typename, typename> class vector;
 namespace detail {
 
 template<typename T>
-struct epoch;
+T* to_address(T* p) noexcept
+{
+  return p;
+}
 
-template<typename T>
-using epoch_pointer = std::shared_ptr<epoch<T>>;
+template<typename Pointer>
+typename std::pointer_traits<Pointer>::element_type*
+to_address(const Pointer& p) noexcept
+{
+  return p? std::addressof(*p): nullptr;
+}
 
-template<typename T>
-struct epoch
+template<typename Pointer>
+Pointer to_pointer(typename std::pointer_traits<Pointer>::element_type* p)
 {
-  epoch(
-    T* data_ = nullptr, std::size_t index_ = 0, std::ptrdiff_t offset_ =0):
-    data{data_}, index{index_}, offset{offset_} {}
+  return p? std::pointer_traits<Pointer>::pointer_to(*p): Pointer();
+}
+
+/* The epoch machinery is instantiated on the allocator rebound to bytes
+ * rather than to T, so that its code is shared by all element types with
+ * the same allocator template. Epochs store data as a byte pointer, cast
+ * back to T by the iterators.
+ */
+
+template<typename Allocator>
+using epoch_allocator =
+  typename std::allocator_traits<Allocator>::template
+    rebind_alloc<unsigned char>;
+
+template<typename T, typename Pointer>
+T* data_cast(const Pointer& p) noexcept
+{
+  return static_cast<T*>(static_cast<void*>(to_address(p)));
+}
+
+/* An epoch shift with offset > 0 records the insertion of offset elements
+ * at index, one with offset < 0 the erasure of the range
+ * [index + offset, index), and offset == 0 means no shift at all. A
+ * relocation (moved_to != no_relocation, only with offset == -1) records
+ * that the element at index - 1 was moved to moved_to rather than erased,
+ * the element previously at moved_to being the one erased.
+ */
+
+struct epoch_shift
+{
+#if defined(SEMISTABLE_COMPACT_EPOCHS)
+  using index_type = std::uint32_t;
+  using offset_type = std::int32_t;
+#else
+  using index_type = std::size_t;
+  using offset_type = std::ptrdiff_t;
+#endif
+
+  static constexpr index_type  no_relocation = (index_type)-1;
+
+  /* Offsets go up to the size, and so do indices, minus the two values
+   * reserved for no_relocation and epoch_node's composite tag.
+   */
+
+  static constexpr std::size_t max_size =
+    (std::size_t)(std::numeric_limits<offset_type>::max)() <
+      (std::size_t)(index_type)-1 - 2?
+    (std::size_t)(std::numeric_limits<offset_type>::max)():
+    (std::size_t)(index_type)-1 - 2;
+
+  epoch_shift(
+    std::size_t index_ = 0, std::ptrdiff_t offset_ = 0,
+    std::size_t moved_to_ = no_relocation) noexcept:
+    index{(index_type)index_}, offset{(offset_type)offset_},
+    moved_to{(index_type)moved_to_} {}
+
+  static_assert(
+    max_size <= (std::size_t)(std::numeric_limits<offset_type>::max)() &&
+    max_size < (std::size_t)(index_type)-1 - 1,
+    "shifts of up to max_size elements must be representable");
+
+  /* Position of the element at i after the shift. */
+
+  std::size_t element(std::size_t i) const noexcept
+  {
+    if(i >= index) i += offset;
+    else if(BOOST_UNLIKELY(moved_to != no_relocation && i + 1 == index)) {
+      i = moved_to;
+    }
+    return i;
+  }
+
+  /* Positions in between elements, rather than at elements as tracked by
+   * iterators: when elements are inserted right at pos, pos moves past them
+   * only if advance_on_insertion is true; positions within an erased range
+   * collapse to its beginning. A relocation counts as the erasure of the
+   * element moved.
+   */
+
+  std::size_t position(
+    std::size_t pos, bool advance_on_insertion) const noexcept
+  {
+    if(offset > 0) {
+      if(pos > index || (pos == index && advance_on_insertion)) {
+        pos += offset;
+      }
+    }
+    else if(pos >= index) pos += offset;
+    else if(pos > index + offset) pos = index + offset;
+    return pos;
+  }
+
+  /* Composes x after *this if the result is again a single shift. Fusion
+   * must keep positions within erased ranges tracked exactly as if *this
+   * and x were applied in succession (see position()).
+   */
 
-  bool try_fuse(epoch& x) noexcept
+  bool try_fuse(const epoch_shift& x) noexcept
   {
-    if(offset <= 0 ?
-         x.index == index :
-         x.index >= index && x.index <= index + offset) {
-      data = x.data;
+    if(x.offset == 0) {
+      /* nothing to compose */
+    }
+    else if(offset == 0) {
+      index = x.index;
+      offset = x.offset;
+      moved_to = x.moved_to;
+    }
+    else if(moved_to != no_relocation || x.moved_to != no_relocation) {
+      return false;
+    }
+    else if(offset > 0) {
+      /* x inserts into or erases within the range inserted by *this */
+
+      if(x.index > index + offset ||
+         (x.offset > 0 ? x.index < index : x.index + x.offset < index)) {
+        return false;
+      }
       offset += x.offset;
-      next = std::move(x.next);
-      return true;
     }
-    return false;
+    else if(x.offset < 0 && x.index == index + offset) {
+      /* x erases right before the range erased by *this */
+
+      offset += x.offset;
+    }
+    else if(x.offset < 0 && x.index + x.offset == index + offset) {
+      /* x erases right after the range erased by *this */
+
+      index -= x.offset;
+      offset += x.offset;
+    }
+    else return false;
+    return true;
+  }
+
+  index_type  index;
+  offset_type offset;
+  index_type  moved_to;
+};
+
+/* Monotone map of positions made of at most max_pieces pieces, each a
+ * translation or a constant, as results from composing shifts other than
+ * relocations: for pos in [pieces[j].first, pieces[j + 1].first), the image
+ * is pieces[j].value plus, unless the piece is flat, pos - pieces[j].first.
+ * pieces[0].first is 0.
+ */
+
+struct epoch_map
+{
+  static constexpr std::size_t max_pieces = 8;
+
+  struct piece
+  {
+    std::size_t first;
+    std::size_t value;
+    bool        flat;
+  };
+
+  /* map of s.position(pos, advance_on_insertion) */
+
+  static epoch_map from_shift(
+    const epoch_shift& s, bool advance_on_insertion) noexcept
+  {
+    epoch_map res;
+    res.size = 0;
+    res.pieces[res.size++] = {0, 0, false};
+    if(s.offset > 0) {
+      auto i = s.index + (advance_on_insertion? 0: 1);
+      res.pieces[res.size++] = {i, i + (std::size_t)s.offset, false};
+    }
+    else if(s.offset < 0) {
+      auto i = s.index + s.offset;
+      res.pieces[res.size++] = {i + 1, i, true};
+      res.pieces[res.size++] = {s.index, i, false};
+    }
+    res.size = normalize(res.pieces, res.size);
+    return res;
+  }
+
+  std::size_t operator()(std::size_t pos) const noexcept
+  {
+    auto j = find(pos);
+    return pieces[j].flat?
+      pieces[j].value: pieces[j].value + (pos - pieces[j].first);
+  }
+
+  /* Composes x after *this, leaving *this untouched if the result has more
+   * than max_pieces pieces.
+   */
+
+  bool try_compose(const epoch_map& x) noexcept
+  {
+    /* each piece of x splits at most one translation of *this */
+
+    piece       res[2 * max_pieces];
+    std::size_t n = 0;
+
+    for(std::size_t j = 0; j < size; ++j) {
+      const auto& p = pieces[j];
+      if(p.flat) {
+        res[n++] = {p.first, x(p.value), true};
+        continue;
+      }
+
+      /* p translates [p.first, p.first + len) to [p.value, p.value + len) */
+
+      auto len = j + 1 < size?
+        pieces[j + 1].first - p.first: (std::size_t)-1;
+      auto k = x.find(p.value);
+      res[n++] = {p.first, x(p.value), x.pieces[k].flat};
+      while(++k < x.size && x.pieces[k].first - p.value < len) {
+        res[n++] = {
+          p.first + (x.pieces[k].first - p.value),
+          x.pieces[k].value, x.pieces[k].flat};
+      }
+    }
+    n = normalize(res, n);
+    if(n > max_pieces) return false;
+    std::copy(res, res + n, pieces);
+    size = n;
+    return true;
+  }
+
+  std::size_t size;
+  piece       pieces[max_pieces];
+
+private:
+  std::size_t find(std::size_t pos) const noexcept
+  {
+    std::size_t j = 0;
+    while(j + 1 < size && pieces[j + 1].first <= pos) ++j;
+    return j;
+  }
+
+  /* Merges in place pieces continuing the previous one. A piece one
+   * position long is both a translation and a constant, so it merges with
+   * either kind.
+   */
+
+  static std::size_t normalize(piece* p, std::size_t n) noexcept
+  {
+    std::size_t m = 0;
+    bool        single = false; /* p[m - 1] is one position long */
+
+    for(std::size_t j = 0; j < n; ++j) {
+      auto q = p[j];
+      bool q_single = j + 1 < n && p[j + 1].first == q.first + 1;
+      if(m) {
+        auto& r = p[m - 1];
+        if(single) {
+          if(q.value == r.value && (q_single || q.flat)) {
+            r.flat = true;
+            single = false;
+            continue;
+          }
+          else if(q.value == r.value + 1 && (q_single || !q.flat)) {
+            r.flat = false;
+            single = false;
+            continue;
+          }
+        }
+        else {
+          auto v = r.flat? r.value: r.value + (q.first - r.first);
+          if(v == q.value && (q_single || q.flat == r.flat)) continue;
+        }
+      }
+      p[m++] = q;
+      single = q_single;
+    }
+    return m;
+  }
+};
+
+/* Maps of an epoch node composed of several shifts, indexed by
+ * advance_on_insertion.
+ */
+
+struct epoch_composite
+{
+  epoch_map maps[2];
+};
+
+/* An epoch is a shift plus the data buffer after it (offset == 0 then means
+ * only data has changed). data is stored as the allocator's pointer type so
+ * that epochs can live in shared memory. It goes before the shift so that
+ * the members of epoch_node can start in the padding after 32-bit shifts.
+ */
+
+template<typename Pointer>
+struct epoch_data
+{
+  Pointer data;
+};
+
+template<typename Pointer>
+struct epoch: epoch_data<Pointer>, epoch_shift
+{
+  using element_type = typename std::pointer_traits<Pointer>::element_type;
+
+  epoch(
+    void* data_ = nullptr,
+    std::size_t index_ = 0, std::ptrdiff_t offset_ =0,
+    std::size_t moved_to_ = no_relocation):
+    epoch_data<Pointer>{
+      to_pointer<Pointer>(static_cast<element_type*>(data_))},
+    epoch_shift{index_, offset_, moved_to_} {}
+};
+
+/* Epochs referred to through raw pointers are process-local, and their
+ * reference counts can skip atomic operations while the program is
+ * single-threaded, as libstdc++'s std::shared_ptr does. Counts of epochs
+ * referred to through fancy pointers (e.g. in shared memory) are always
+ * atomic.
+ */
+
+template<bool ProcessLocal>
+struct epoch_refcount
+{
+  epoch_refcount(long n_) noexcept: n{n_} {}
+
+  void add() noexcept { n.fetch_add(1, std::memory_order_relaxed); }
+
+  bool release() noexcept
+  {
+    return n.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  long load() const noexcept { return n.load(std::memory_order_relaxed); }
+
+  void store(long n_) noexcept { n.store(n_, std::memory_order_relaxed); }
+
+  std::atomic<long> n;
+};
+
+#if defined(BOOST_LIBSTDCXX_VERSION)
+template<>
+struct epoch_refcount<true>
+{
+  epoch_refcount(long n_) noexcept: n{(_Atomic_word)n_} {}
+
+  void add() noexcept { __gnu_cxx::__atomic_add_dispatch(&n, 1); }
+
+  bool release() noexcept
+  {
+    return __gnu_cxx::__exchange_and_add_dispatch(&n, -1) == 1;
+  }
+
+  long load() const noexcept { return __atomic_load_n(&n, __ATOMIC_RELAXED); }
+
+  void store(long n_) noexcept
+  {
+    __atomic_store_n(&n, (_Atomic_word)n_, __ATOMIC_RELAXED);
+  }
+
+  _Atomic_word n;
+};
+#endif
+
+template<typename Allocator>
+struct epoch_node;
+
+/* Thread-local free list of Node's allocated with std::allocator, shared by
+ * all the vectors in the thread so that short-lived vectors don't allocate
+ * their epochs afresh. Nodes may be freed in a thread other than the one
+ * that allocated them, so each cache gets whatever nodes its thread frees.
+ * When full, half the cache is returned to the allocator at once. The
+ * state is trivially destructible so that it's usable at any point of the
+ * thread's lifetime: the first node cached also registers a thread-local
+ * closer that empties the cache on thread exit, after which nodes go
+ * straight back to the allocator.
+ */
+
+template<typename Node>
+struct epoch_cache
+{
+  static constexpr std::size_t capacity = SEMISTABLE_EPOCH_CACHE_SIZE;
+  static_assert(capacity >= 2, "SEMISTABLE_EPOCH_CACHE_SIZE must be >= 2");
+
+  static Node* pop() noexcept
+  {
+    auto& s = state();
+    auto  p = s.head;
+    if(!p) return nullptr;
+    s.head = p->next;
+    --s.size;
+    return reinterpret_cast<Node*>(p);
+  }
+
+  static void push(Node* p) noexcept
+  {
+    auto& s = state();
+    if(BOOST_UNLIKELY(s.closed)) {
+      deallocate(p);
+      return;
+    }
+    if(BOOST_UNLIKELY(!s.open)) {
+      s.open = true;
+      register_closer();
+    }
+    if(s.size == capacity) trim(capacity / 2);
+    s.head = ::new (static_cast<void*>(p)) free_node{s.head};
+    ++s.size;
+  }
+
+  static void clear() noexcept { trim(capacity); }
+
+private:
+  static_assert(
+    sizeof(Node) >= sizeof(void*) && alignof(Node) >= alignof(void*),
+    "Node can't hold a free list link");
+
+  struct free_node
+  {
+    free_node* next;
+  };
+
+  struct state_type
+  {
+    free_node*  head;
+    std::size_t size;
+    bool        open, closed;
+  };
+
+  struct closer
+  {
+    ~closer()
+    {
+      trim(capacity);
+      state().closed = true;
+    }
+  };
+
+  static state_type& state() noexcept
+  {
+    static thread_local state_type s{nullptr, 0, false, false};
+    return s;
+  }
+
+  static void register_closer() noexcept
+  {
+    static thread_local closer c;
+    (void)c;
+  }
+
+  static void trim(std::size_t n) noexcept
+  {
+    while(n--) {
+      auto p = pop();
+      if(!p) break;
+      deallocate(p);
+    }
+  }
+
+  static void deallocate(Node* p) noexcept
+  {
+    std::allocator<Node>{}.deallocate(p, 1);
+  }
+};
+
+/* Intrusive counterpart of std::shared_ptr<epoch_node<Allocator>>: nodes are
+ * allocated with (a rebound copy of) the vector's allocator and referred to
+ * through its pointer type, so that epoch chains can be placed along with
+ * their vector in shared memory.
+ */
+
+template<typename Allocator>
+class epoch_pointer
+{
+  using node_type = epoch_node<Allocator>;
+  using node_allocator_type =
+    typename std::allocator_traits<Allocator>::template
+      rebind_alloc<node_type>;
+  using node_alloc_traits = std::allocator_traits<node_allocator_type>;
+  using node_pointer = typename node_alloc_traits::pointer;
+
+public:
+  epoch_pointer() noexcept: p{} {}
+  epoch_pointer(std::nullptr_t) noexcept: p{} {}
+  epoch_pointer(const epoch_pointer& x) noexcept: p{x.p} { acquire(); }
+  epoch_pointer(epoch_pointer&& x) noexcept: p{x.p} { x.p = node_pointer(); }
+  ~epoch_pointer() { release(); }
+
+  epoch_pointer& operator=(const epoch_pointer& x) noexcept
+  {
+    epoch_pointer{x}.swap(*this);
+    return *this;
   }
 
-  ~epoch()
+  epoch_pointer& operator=(epoch_pointer&& x) noexcept
   {
+    epoch_pointer{std::move(x)}.swap(*this);
+    return *this;
+  }
+
+  template<typename OtherAllocator, typename... Args>
+  static epoch_pointer allocate(const OtherAllocator& al, Args&&... args)
+  {
+    node_allocator_type nal{al};
+    epoch_pointer       res;
+    res.p = allocate_node(nal, use_cache{});
+    node_alloc_traits::construct(
+      nal, detail::to_address(res.p), nal, std::forward<Args>(args)...);
+    return res;
+  }
+
+  /* frees the nodes cached by the current thread, if any */
+
+  static void clear_cache() noexcept { clear_cache(use_cache{}); }
+
+  node_type* get() const noexcept { return detail::to_address(p); }
+  node_type& operator*() const noexcept { return *get(); }
+  node_type* operator->() const noexcept { return get(); }
+  explicit operator bool() const noexcept { return get() != nullptr; }
+
+  long use_count() const noexcept
+  {
+    return p? p->refs.load(): 0;
+  }
+
+  void swap(epoch_pointer& x) noexcept
+  {
+    node_pointer tmp = p;
+    p = x.p;
+    x.p = tmp;
+  }
+
+  friend bool operator==(
+    const epoch_pointer& x, const epoch_pointer& y) noexcept
+  {
+    return x.p == y.p;
+  }
+
+  friend bool operator!=(
+    const epoch_pointer& x, const epoch_pointer& y) noexcept
+  {
+    return x.p != y.p;
+  }
+
+private:
+  void acquire() noexcept
+  {
+    if(p) p->refs.add();
+  }
+
+  void release() noexcept
+  {
+    if(p && p->refs.release()) {
+      node_allocator_type nal{p->get_allocator()};
+      node_alloc_traits::destroy(nal, detail::to_address(p));
+      deallocate_node(nal, p, use_cache{});
+    }
+  }
+
+  /* nodes from stateful or fancy allocators are never cached */
+
+#if defined(SEMISTABLE_NO_EPOCH_CACHE)
+  using use_cache = std::false_type;
+#else
+  using use_cache = std::integral_constant<
+    bool,
+    std::is_same<node_allocator_type, std::allocator<node_type>>::value>;
+#endif
+
+  static node_pointer allocate_node(node_allocator_type& nal, std::true_type)
+  {
+    if(auto q = epoch_cache<node_type>::pop()) return q;
+    return node_alloc_traits::allocate(nal, 1);
+  }
+
+  static node_pointer allocate_node(node_allocator_type& nal, std::false_type)
+  {
+    return node_alloc_traits::allocate(nal, 1);
+  }
+
+  static void deallocate_node(
+    node_allocator_type&, node_pointer q, std::true_type) noexcept
+  {
+    epoch_cache<node_type>::push(q);
+  }
+
+  static void deallocate_node(
+    node_allocator_type& nal, node_pointer q, std::false_type) noexcept
+  {
+    node_alloc_traits::deallocate(nal, q, 1);
+  }
+
+  static void clear_cache(std::true_type) noexcept
+  {
+    epoch_cache<node_type>::clear();
+  }
+
+  static void clear_cache(std::false_type) noexcept {}
+
+  node_pointer p;
+};
+
+template<typename Allocator>
+struct epoch_node:
+  epoch<typename std::allocator_traits<Allocator>::pointer>,
+  private boost::empty_value<
+    typename std::allocator_traits<Allocator>::template
+      rebind_alloc<epoch_node<Allocator>>>
+{
+  using epoch_type = epoch<typename std::allocator_traits<Allocator>::pointer>;
+  using allocator_type =
+    typename std::allocator_traits<Allocator>::template
+      rebind_alloc<epoch_node>;
+  using node_pointer =
+    typename std::allocator_traits<allocator_type>::pointer;
+  using refcount_type =
+    epoch_refcount<std::is_pointer<node_pointer>::value>;
+
+  epoch_node(const allocator_type& al, const epoch_type& x = epoch_type{}):
+    epoch_type{x}, allocator_base{boost::empty_init_t(), al}, refs{1} {}
+
+  epoch_node(const epoch_node&) = delete;
+
+  epoch_node& operator=(const epoch_type& x) noexcept
+  {
+    epoch_type::operator=(x);
+    next = nullptr;
+    ahead = nullptr;
+    return *this;
+  }
+
+  const allocator_type& get_allocator() const noexcept
+  {
+    return allocator_base::get();
+  }
+
+  std::size_t element(std::size_t i) const noexcept
+  {
+    /* elements not erased move as positions advancing on insertion */
+
+    if(BOOST_UNLIKELY(composed())) return comp->maps[1](i);
+    else return epoch_shift::element(i);
+  }
+
+  std::size_t position(
+    std::size_t pos, bool advance_on_insertion) const noexcept
+  {
+    if(BOOST_UNLIKELY(composed())) {
+      return comp->maps[advance_on_insertion](pos);
+    }
+    else return epoch_shift::position(pos, advance_on_insertion);
+  }
+
+  /* Fuses x into *this as a single shift if possible, or else as a
+   * composite map (see try_compose). Throws only if *this is left
+   * untouched.
+   */
+
+  bool try_fuse(epoch_node& x)
+  {
+    if((composed() || x.composed() || !epoch_shift::try_fuse(x)) &&
+       !try_compose(x)) {
+      return false;
+    }
+    this->data = x.data;
+    next = std::move(x.next);
+    return true;
+  }
+
+  ~epoch_node()
+  {
+    SEMISTABLE_PROBE1(epoch_destroy, this);
+
     /* prevents recursive destruction */
 
     while(next.use_count() == 1) {
       auto tmp = std::move(next);
       next = std::move(tmp->next);
     }
+    if(comp) {
+      composite_allocator_type cal{get_allocator()};
+      composite_alloc_traits::destroy(cal, detail::to_address(comp));
+      composite_alloc_traits::deallocate(cal, comp, 1);
+    }
+  }
+
+  /* refs goes first to fill the padding left by 32-bit shifts */
+
+  refcount_type            refs;
+  epoch_pointer<Allocator> next;
+  node_pointer             ahead; /* non-owning, see catch_up */
+
+private:
+  using allocator_base = boost::empty_value<allocator_type>;
+  using composite_allocator_type =
+    typename std::allocator_traits<Allocator>::template
+      rebind_alloc<epoch_composite>;
+  using composite_alloc_traits =
+    std::allocator_traits<composite_allocator_type>;
+  using composite_pointer = typename composite_alloc_traits::pointer;
+
+  /* Composing any two shifts other than relocations gives a piecewise map
+   * with as many pieces as both together, so runs of unrelated insertions
+   * and erasures collapse into one node till the map is full. The map is
+   * allocated on first use and kept for when the node is reused.
+   */
+
+  /* moved_to of a composed node is the composite tag */
+
+  static constexpr typename epoch_shift::index_type composite_tag =
+    epoch_shift::no_relocation - 1;
+
+  bool composed() const noexcept { return this->moved_to == composite_tag; }
+
+  bool try_compose(const epoch_node& x)
+  {
+    if((!composed() && this->moved_to != epoch_shift::no_relocation) ||
+       (!x.composed() && x.moved_to != epoch_shift::no_relocation)) {
+      return false;
+    }
+
+    epoch_composite res;
+    for(int advance = 0; advance < 2; ++advance) {
+      auto& m = res.maps[advance];
+      m = composed()?
+        comp->maps[advance]: epoch_map::from_shift(*this, advance != 0);
+      if(!m.try_compose(x.composed()?
+           x.comp->maps[advance]: epoch_map::from_shift(x, advance != 0))) {
+        return false;
+      }
+    }
+    if(!comp) {
+      composite_allocator_type cal{get_allocator()};
+      auto p = composite_alloc_traits::allocate(cal, 1);
+      composite_alloc_traits::construct(cal, detail::to_address(p));
+      comp = p;
+    }
+    *comp = res;
+    this->moved_to = composite_tag;
+    return true;
   }
 
-  T*               data;
-  std::size_t      index;
-  std::ptrdiff_t   offset;
-  epoch_pointer<T> next;
+  composite_pointer comp = composite_pointer();
 };
 
-template<typename T>
+/* Epochs prior to the head remembered by a vector, newest first: prev[0]
+ * is right behind the head and prev[i + 1]->next is prev[i]. The epochs held
+ * are a prefix of prev.
+ */
+
+template<typename Allocator>
+struct epoch_history
+{
+  static constexpr std::size_t capacity = SEMISTABLE_EPOCH_LOOKBACK;
+  static_assert(capacity >= 1, "SEMISTABLE_EPOCH_LOOKBACK must be positive");
+
+  epoch_pointer<Allocator>& operator[](std::size_t i) noexcept
+  {
+    return prev[i];
+  }
+
+  const epoch_pointer<Allocator>& operator[](std::size_t i) const noexcept
+  {
+    return prev[i];
+  }
+
+  std::size_t size() const noexcept
+  {
+    std::size_t n = 0;
+    while(n < capacity && prev[n]) ++n;
+    return n;
+  }
+
+  /* pe becomes the newest epoch held, the oldest one is dropped if full */
+
+  void push(epoch_pointer<Allocator>&& pe) noexcept
+  {
+    for(std::size_t i = capacity - 1; i > 0; --i) {
+      prev[i] = std::move(prev[i - 1]);
+    }
+    prev[0] = std::move(pe);
+  }
+
+  /* epochs older than the one removed move one position up */
+
+  epoch_pointer<Allocator> remove(std::size_t i) noexcept
+  {
+    auto res = std::move(prev[i]);
+    for(; i + 1 < capacity; ++i) prev[i] = std::move(prev[i + 1]);
+    return res;
+  }
+
+  void swap(epoch_history& x) noexcept
+  {
+    for(std::size_t i = 0; i < capacity; ++i) prev[i].swap(x.prev[i]);
+  }
+
+  epoch_pointer<Allocator> prev[capacity];
+};
+
+/* Walks the epoch chain from pe to its head calling f on each epoch past pe.
+ * Links are followed without touching reference counts, as the chain is kept
+ * alive by pe, which is moved to the head only at the end. Chains long
+ * enough to be worth walking are usually cold, so each hop prefetches the
+ * node several positions ahead as recorded in the ahead skip link (see
+ * vector::epoch_transaction::commit). ahead is only a hint and may point to
+ * a node no longer in the chain, or even to released memory: prefetching
+ * never faults.
+ */
+
+template<typename Allocator, typename F>
+void catch_up(epoch_pointer<Allocator>& pe, F f) noexcept
+{
+  const epoch_pointer<Allocator>* pl = &pe->next;
+  std::size_t                     steps = 0;
+  SEMISTABLE_PROBE1(catch_up_begin, pe.get());
+  for(;;) {
+    auto& e = **pl;
+    SEMISTABLE_PREFETCH(detail::to_address(e.ahead));
+    f(e);
+    ++steps;
+    if(!e.next) break;
+    pl = &e.next;
+  }
+  pe = *pl;
+  SEMISTABLE_PROBE2(catch_up_end, pe.get(), steps);
+  (void)steps;
+}
+
+/* Walks of element indices (iterators) and of position ranges (marker
+ * ranges, scan cursors) over the chain. They depend on the allocator family
+ * only, so that the views of every element type, const or not, share a
+ * single instantiation rather than one per lambda.
+ */
+
+template<typename Allocator>
+std::size_t catch_up_element(
+  epoch_pointer<Allocator>& pe, std::size_t i) noexcept
+{
+  catch_up(pe, [&] (const epoch_node<Allocator>& e) { i = e.element(i); });
+  return i;
+}
+
+template<typename Allocator>
+std::pair<std::size_t, std::size_t> catch_up_range(
+  epoch_pointer<Allocator>& pe, std::size_t first, std::size_t last,
+  bool advance_first, bool advance_last) noexcept
+{
+  catch_up(pe, [&] (const epoch_node<Allocator>& e) {
+    first = e.position(first, advance_first);
+    last = e.position(last, advance_last);
+    if(last < first) last = first; /* right gravity first, left last */
+  });
+  return {first, last};
+}
+
+template<typename T, typename Allocator>
 class iterator
 {
-  using epoch_pointer =
-    detail::epoch_pointer<typename std::remove_const<T>::type>;
+  using epoch_pointer = detail::epoch_pointer<epoch_allocator<Allocator>>;
   template<typename Q>
   using enable_if_consts_to_value_type_t =
     typename std::enable_if<std::is_same<const Q, T>::value>::type;
@@ -126,13 +1017,15 @@ public:
     typename Q,
     typename = enable_if_consts_to_value_type_t<Q>
   >
-  iterator(const iterator<Q>& x) noexcept: idx{x.index()}, pe{x.pe} {}
+  iterator(const iterator<Q, Allocator>& x) noexcept:
+    idx{x.index()}, pe{x.pe} {}
       
   template<
     typename Q,
     typename = enable_if_consts_to_value_type_t<Q>
   >
-  iterator(iterator<Q>&& x) noexcept: idx{x.index()}, pe{std::move(x.pe)} {}
+  iterator(iterator<Q, Allocator>&& x) noexcept:
+    idx{x.index()}, pe{std::move(x.pe)} {}
 
   iterator& operator=(const iterator& x) noexcept
   {
@@ -152,7 +1045,7 @@ public:
     typename Q,
     typename = enable_if_consts_to_value_type_t<Q>
   >
-  iterator& operator=(const iterator<Q>& x) noexcept
+  iterator& operator=(const iterator<Q, Allocator>& x) noexcept
   {
     idx = x.index();
     pe = x.pe;
@@ -163,7 +1056,7 @@ public:
     typename Q,
     typename = enable_if_consts_to_value_type_t<Q>
   >
-  iterator& operator=(iterator<Q>&& x) noexcept
+  iterator& operator=(iterator<Q, Allocator>&& x) noexcept
   {
     idx = x.index();
     pe = std::move(x.pe);
@@ -173,7 +1066,7 @@ public:
   pointer raw() const noexcept 
   {
     update();
-    return pe->data+idx;
+    return detail::data_cast<T>(pe->data) + idx;
   }
 
   pointer operator->() const noexcept
@@ -218,92 +1111,245 @@ public:
     return (difference_type)(x.index() - y.index());
   }
 
-  iterator& operator+=(difference_type n) noexcept
+  iterator& operator+=(difference_type n) noexcept
+  {
+    index() += n;
+    return *this;
+  }
+    
+  friend iterator operator+(const iterator& x, difference_type n) noexcept
+  {
+    x.update();
+    return {x.idx + n, x.pe};
+  }
+
+  friend iterator operator+(difference_type n, const iterator& x) noexcept
+  {
+    x.update();
+    return {n + x.idx, x.pe};
+  }
+
+  iterator& operator-=(difference_type n) noexcept
+  {
+    index() -= n;
+    return *this;
+  }
+    
+  friend iterator operator-(const iterator& x, difference_type n) noexcept
+  {
+    x.update();
+    return {x.idx - n, x.pe};
+  }
+
+  reference operator[](difference_type n)const noexcept
+  {
+    return raw()[n];
+  }
+
+  friend bool operator==(const iterator& x, const iterator& y) noexcept
+  {
+    return x.index() == y.index();
+  }
+  
+  friend bool operator!=(const iterator& x, const iterator& y) noexcept
+  {
+    return x.index() != y.index();
+  }
+
+  friend bool operator<(const iterator& x, const iterator& y) noexcept
+  {
+    return x.index() < y.index();
+  }
+
+  friend bool operator>(const iterator& x, const iterator& y) noexcept
+  {
+    return x.index() > y.index();
+  }
+
+  friend bool operator<=(const iterator& x, const iterator& y) noexcept
+  {
+    return x.index() <= y.index();
+  }
+
+  friend bool operator>=(const iterator& x, const iterator& y) noexcept
+  {
+    return x.index() >= y.index();
+  }
+
+private:
+  template<typename, typename> friend class iterator;
+  template<typename, typename> friend class semistable::vector;
+
+  void update() const noexcept
+  {
+    if(BOOST_UNLIKELY(pe->next.get() != nullptr)) {
+      idx = detail::catch_up_element(pe, idx);
+    }
+  }
+  
+  std::size_t& index() const noexcept
+  {
+    update();
+    return idx;
+  }
+
+  mutable std::size_t   idx;
+  mutable epoch_pointer pe;
+};
+
+/* Counterpart of std::reverse_iterator<iterator<T, Allocator>> dereferencing
+ * through current.raw()[-1] rather than through a decremented copy of
+ * current, which would cost a reference count round trip per access.
+ */
+
+template<typename T, typename Allocator>
+class reverse_iterator
+{
+  using base_iterator = iterator<T, Allocator>;
+  template<typename Q>
+  using enable_if_consts_to_value_type_t =
+    typename std::enable_if<std::is_same<const Q, T>::value>::type;
+
+public:
+  using iterator_type = base_iterator;
+  using value_type = typename base_iterator::value_type;
+  using difference_type = typename base_iterator::difference_type;
+  using pointer = typename base_iterator::pointer;
+  using reference = typename base_iterator::reference;
+  using iterator_category = std::random_access_iterator_tag;
+
+  reverse_iterator() = default;
+  explicit reverse_iterator(const base_iterator& x) noexcept: current{x} {}
+  explicit reverse_iterator(base_iterator&& x) noexcept:
+    current{std::move(x)} {}
+
+  template<
+    typename Q,
+    typename = enable_if_consts_to_value_type_t<Q>
+  >
+  reverse_iterator(const reverse_iterator<Q, Allocator>& x) noexcept:
+    current{x.current} {}
+
+  template<
+    typename Q,
+    typename = enable_if_consts_to_value_type_t<Q>
+  >
+  reverse_iterator(reverse_iterator<Q, Allocator>&& x) noexcept:
+    current{std::move(x.current)} {}
+
+  base_iterator base() const noexcept { return current; }
+
+  pointer raw() const noexcept { return current.raw() - 1; }
+  pointer operator->() const noexcept { return raw(); }
+  reference operator*() const noexcept { return *raw(); }
+
+  reference operator[](difference_type n) const noexcept
+  {
+    return current.raw()[-n - 1];
+  }
+
+  reverse_iterator& operator++() noexcept
+  {
+    --current;
+    return *this;
+  }
+
+  reverse_iterator operator++(int) noexcept
+  {
+    reverse_iterator tmp(*this);
+    --current;
+    return tmp;
+  }
+
+  reverse_iterator& operator--() noexcept
   {
-    index() += n;
+    ++current;
     return *this;
   }
-    
-  friend iterator operator+(const iterator& x, difference_type n) noexcept
+
+  reverse_iterator operator--(int) noexcept
   {
-    x.update();
-    return {x.idx + n, x.pe};
+    reverse_iterator tmp(*this);
+    ++current;
+    return tmp;
   }
 
-  friend iterator operator+(difference_type n, const iterator& x) noexcept
+  reverse_iterator& operator+=(difference_type n) noexcept
   {
-    x.update();
-    return {n + x.idx, x.pe};
+    current -= n;
+    return *this;
   }
 
-  iterator& operator-=(difference_type n) noexcept
+  reverse_iterator& operator-=(difference_type n) noexcept
   {
-    index() -= n;
+    current += n;
     return *this;
   }
-    
-  friend iterator operator-(const iterator& x, difference_type n) noexcept
+
+  friend reverse_iterator
+  operator+(const reverse_iterator& x, difference_type n) noexcept
   {
-    x.update();
-    return {x.idx - n, x.pe};
+    return reverse_iterator{x.current - n};
   }
 
-  reference operator[](difference_type n)const noexcept
+  friend reverse_iterator
+  operator+(difference_type n, const reverse_iterator& x) noexcept
   {
-    return raw()[n];
+    return reverse_iterator{x.current - n};
   }
 
-  friend bool operator==(const iterator& x, const iterator& y) noexcept
+  friend reverse_iterator
+  operator-(const reverse_iterator& x, difference_type n) noexcept
   {
-    return x.index() == y.index();
+    return reverse_iterator{x.current + n};
   }
-  
-  friend bool operator!=(const iterator& x, const iterator& y) noexcept
+
+  friend difference_type
+  operator-(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    return x.index() != y.index();
+    return y.current - x.current;
   }
 
-  friend bool operator<(const iterator& x, const iterator& y) noexcept
+  friend bool
+  operator==(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    return x.index() < y.index();
+    return x.current == y.current;
   }
 
-  friend bool operator>(const iterator& x, const iterator& y) noexcept
+  friend bool
+  operator!=(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    return x.index() > y.index();
+    return x.current != y.current;
   }
 
-  friend bool operator<=(const iterator& x, const iterator& y) noexcept
+  friend bool
+  operator<(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    return x.index() <= y.index();
+    return x.current > y.current;
   }
 
-  friend bool operator>=(const iterator& x, const iterator& y) noexcept
+  friend bool
+  operator>(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    return x.index() >= y.index();
+    return x.current < y.current;
   }
 
-private:
-  template<typename> friend class iterator;
-  template<typename, typename> friend class semistable::vector;
-
-  void update() const noexcept
+  friend bool
+  operator<=(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    while(BOOST_UNLIKELY(pe->next.get() != nullptr)){
-      pe = pe->next;
-      auto& e = *pe;
-      if(idx >= e.index) idx += e.offset;
-    }
+    return x.current >= y.current;
   }
-  
-  std::size_t& index() const noexcept
+
+  friend bool
+  operator>=(const reverse_iterator& x, const reverse_iterator& y) noexcept
   {
-    update();
-    return idx;
+    return x.current <= y.current;
   }
 
-  mutable std::size_t   idx;
-  mutable epoch_pointer pe;
+private:
+  template<typename, typename> friend class reverse_iterator;
+
+  base_iterator current;
 };
 
 template<typename T>
@@ -312,6 +1358,82 @@ struct type_identity { using type = T; };
 template<typename T>
 using type_identity_t = typename type_identity<T>::type;
 
+/* std::vector insertion has no effects if an exception is thrown other than
+ * by the copy/move construction or assignment of T or by an iterator
+ * operation. So, if T's moves don't throw, the strong guarantee is achieved
+ * by constructing new elements in a separate buffer and moving them into
+ * the vector, unless constructing them in place can't throw either.
+ */
+
+template<typename T, bool NothrowConstruction>
+struct needs_insertion_buffer: std::integral_constant<
+  bool,
+  std::is_nothrow_move_constructible<T>::value &&
+  std::is_nothrow_move_assignable<T>::value &&
+  !NothrowConstruction
+>{};
+
+template<typename T, typename... Args>
+using needs_emplacement_buffer = needs_insertion_buffer<
+  T, std::is_nothrow_constructible<T, Args...>::value>;
+
+template<
+  typename T, typename Iterator,
+  typename Reference = typename std::iterator_traits<Iterator>::reference
+>
+struct is_nothrow_insertable_from: std::integral_constant<
+  bool,
+  std::is_nothrow_constructible<T, Reference>::value &&
+  std::is_nothrow_assignable<T&, Reference>::value &&
+  noexcept(*std::declval<Iterator&>()) &&
+  noexcept(++std::declval<Iterator&>()) &&
+  noexcept(std::declval<Iterator&>() == std::declval<Iterator&>()) &&
+  noexcept(std::declval<Iterator&>() != std::declval<Iterator&>())
+>{};
+
+template<typename T, typename Iterator>
+using needs_range_insertion_buffer = needs_insertion_buffer<
+  T, is_nothrow_insertable_from<T, Iterator>::value>;
+
+template<typename T, typename Allocator>
+struct temporary_value
+{
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  template<typename... Args>
+  temporary_value(const Allocator& al_, Args&&... args): al{al_}
+  {
+    alloc_traits::construct(al, get(), std::forward<Args>(args)...);
+  }
+
+  temporary_value(const temporary_value&) = delete;
+  temporary_value& operator=(const temporary_value&) = delete;
+
+  ~temporary_value() { alloc_traits::destroy(al, get()); }
+
+  T* get() noexcept { return reinterpret_cast<T*>(&storage); }
+
+  Allocator al;
+  alignas(T) unsigned char storage[sizeof(T)];
+};
+
+/* Allocators rounding requests up to size classes (jemalloc, tcmalloc) can
+ * tell how many elements an allocation of n actually provides through a
+ * member function allocation_size(n), e.g. implemented with nallocx.
+ * std::vector can't adopt the extra capacity returned by C++23
+ * allocate_at_least, so vector asks for it upfront when growing.
+ */
+
+template<typename Allocator, typename = void>
+struct has_allocation_size: std::false_type{};
+
+template<typename Allocator>
+struct has_allocation_size<
+  Allocator,
+  decltype((void)std::declval<const Allocator&>().allocation_size(
+    std::declval<typename std::allocator_traits<Allocator>::size_type>()))
+>: std::true_type{};
+
 #if !defined(BOOST_NO_CXX20_HDR_CONCEPTS) && \
     !defined(SEMISTABLE_NO_CXX20_HDR_RANGES)
 template<typename R, typename T>
@@ -329,9 +1451,16 @@ struct access
     return x.impl; 
   }
 
-#if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
   template<typename T, typename Allocator>
-  static bool check_invariant(const semistable::vector<T, Allocator>& x)
+  static const typename semistable::vector<T, Allocator>::epoch_pointer&
+  get_epoch(const semistable::vector<T, Allocator>& x)
+  {
+    return x.pe;
+  }
+
+#if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
+  template<typename Container>
+  static bool check_invariant(const Container& x)
   {
     return x.check_invariant(); 
   }
@@ -340,16 +1469,15 @@ struct access
 
 #if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
 
-template<typename T, typename Allocator>
+template<typename Container>
 struct invariant_checker
 {
   ~invariant_checker() { SEMISTABLE_ASSERT(access::check_invariant(x)); }
-  const semistable::vector<T, Allocator>& x;
+  const Container& x;
 };
 
-template<typename T, typename Allocator>
-invariant_checker<T, Allocator>
-make_invariant_checker(const semistable::vector<T, Allocator>& x)
+template<typename Container>
+invariant_checker<Container> make_invariant_checker(const Container& x)
 {
   return {x};
 }
@@ -381,9 +1509,12 @@ template<typename T, typename Allocator = std::allocator<T>>
 class vector
 {
   using impl_type = std::vector<T, Allocator>;
-  using epoch_type = detail::epoch<T>;
-  using epoch_pointer = detail::epoch_pointer<T>;
   using alloc_traits = std::allocator_traits<Allocator>;
+  using epoch_allocator = detail::epoch_allocator<Allocator>;
+  using epoch_node = detail::epoch_node<epoch_allocator>;
+  using epoch_type = typename epoch_node::epoch_type;
+  using epoch_pointer = detail::epoch_pointer<epoch_allocator>;
+  using epoch_node_pointer = typename epoch_node::node_pointer;
 
   static_assert(
     !std::is_const<T>::value && !std::is_volatile<T>::value && 
@@ -408,14 +1539,16 @@ public:
   using const_reference = const T&;
   using size_type = typename alloc_traits::size_type;
   using difference_type = typename alloc_traits::difference_type;
-  using iterator = detail::iterator<T>;
-  using const_iterator = detail::iterator<const T>;
-  using reverse_iterator = std::reverse_iterator<iterator>;
-  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using iterator = detail::iterator<T, Allocator>;
+  using const_iterator = detail::iterator<const T, Allocator>;
+  using reverse_iterator = detail::reverse_iterator<T, Allocator>;
+  using const_reverse_iterator = detail::reverse_iterator<const T, Allocator>;
 
 #if !defined(BOOST_NO_CXX20_HDR_CONCEPTS)
   static_assert(std::contiguous_iterator<iterator>);
   static_assert(std::contiguous_iterator<const_iterator>);
+  static_assert(std::random_access_iterator<reverse_iterator>);
+  static_assert(std::random_access_iterator<const_reverse_iterator>);
 #endif
 
   /* construct/copy/destroy */
@@ -485,7 +1618,8 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
   }
 
-  vector(vector&& x): vector{std::move(x), std::make_shared<epoch_type>()} {}
+  vector(vector&& x):
+    vector{std::move(x), epoch_pointer::allocate(x.impl.get_allocator())} {}
 
   vector(const vector& x, const detail::type_identity_t<Allocator>& al):
     impl{x.impl, al}
@@ -496,10 +1630,10 @@ public:
   vector(vector&& x, const detail::type_identity_t<Allocator>& al):
     vector{
       std::move(x), al,
-      std::make_shared<epoch_type>(), x.size(),
+      epoch_pointer::allocate(x.impl.get_allocator()), x.size(),
       x.impl.get_allocator() == al?
         epoch_pointer{}:
-        std::make_shared<epoch_type>()} {}
+        epoch_pointer::allocate(al)} {}
 
   vector(std::initializer_list<T> il, const Allocator& al = Allocator()):
     impl{il,al}
@@ -510,9 +1644,11 @@ public:
   vector& operator=(const vector& x)
   {
     SEMISTABLE_CHECK_INVARIANT;
+    if(this == &x) return *this;
     new_epoch([&, this] {
       auto n = impl.size();
-      impl = x.impl;
+      copy_assign_impl(
+        x, typename alloc_traits::propagate_on_container_copy_assignment{});
       return epoch_type{impl.data(), n, (difference_type)(impl.size() - n)};
     });
     return *this;
@@ -522,15 +1658,14 @@ public:
   {
     SEMISTABLE_CHECK_INVARIANT_OF(*this);
     SEMISTABLE_CHECK_INVARIANT_OF(x);
-    auto pe_for_x = std::make_shared<epoch_type>(),
+    auto pe_for_x = epoch_pointer::allocate(x.impl.get_allocator()),
          pe_for_this = impl.get_allocator() ==x.impl.get_allocator()?
            epoch_pointer{}:
-           std::make_shared<epoch_type>();
+           epoch_pointer::allocate(impl.get_allocator());
     impl = std::move(x.impl);
     if(!pe_for_this) { /* equal allocators */
       pe = std::move(x.pe);
-      pe1 = std::move(x.pe1);
-      pe2 = std::move(x.pe2);
+      prev = std::move(x.prev);
       x.pe =std::move(pe_for_x);
       *x.pe = {x.impl.data()};
     }
@@ -548,12 +1683,7 @@ public:
 
   vector& operator=(std::initializer_list<T> il)
   {
-    SEMISTABLE_CHECK_INVARIANT;
-    new_epoch([&, this] {
-      auto n = impl.size();
-      impl = il;
-      return epoch_type{impl.data(), n, (difference_type)(impl.size() - n)};
-    });
+    assign(il.begin(), il.end());
     return *this;
   }
 
@@ -571,7 +1701,9 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto n = impl.size();
-      impl.assign(first, last);
+      assign_impl(
+        first, last,
+        typename std::iterator_traits<InputIterator>::iterator_category{});
       return epoch_type{impl.data(), n, (difference_type)(impl.size() - n)};
     });
   }
@@ -588,8 +1720,10 @@ public:
   {
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
-      auto n = impl.size();
-      impl.assign_range(std::forward<R>(rg));
+      auto      n = impl.size();
+      impl_type buf{impl.get_allocator()};
+      buf.assign_range(std::forward<R>(rg));
+      impl.swap(buf);
       return epoch_type{impl.data(), n, (difference_type)(impl.size() - n)};
     });
   }
@@ -599,7 +1733,14 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto m = impl.size();
-      impl.assign(n, value);
+      if(n <= impl.capacity() &&
+         detail::is_nothrow_insertable_from<T, const T*>::value) {
+        impl.assign(n, value);
+      }
+      else {
+        impl_type buf{n, value, impl.get_allocator()};
+        impl.swap(buf);
+      }
       return epoch_type{impl.data(), m, (difference_type)(n - m)};
     });
   }
@@ -636,7 +1777,11 @@ public:
 
   bool      empty() const noexcept { return impl.empty(); }
   size_type size() const noexcept { return impl.size(); }
-  size_type max_size() const noexcept { return impl.max_size(); }
+  size_type max_size() const noexcept
+  {
+    return (std::min)(
+      impl.max_size(), (size_type)detail::epoch_shift::max_size);
+  }
   size_type capacity() const noexcept { return impl.capacity(); }
 
   void resize(size_type n)
@@ -644,6 +1789,7 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto m = impl.size();
+      if(n > m) reserve_grown(n - m);
       impl.resize(n);
       return epoch_type{impl.data(), m, (difference_type)(n - m)};
     });
@@ -654,7 +1800,15 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto m = impl.size();
-      impl.resize(n, value);
+      if(n > m && grows_with_hint(n - m)) {
+        /* value may be an element, hence the temporary */
+
+        detail::temporary_value<T, Allocator> tmp{
+          impl.get_allocator(), value};
+        impl.reserve(grown_capacity(n - m));
+        impl.resize(n, *tmp.get());
+      }
+      else impl.resize(n, value);
       return epoch_type{impl.data(), m, (difference_type)(n - m)};
     });
   }
@@ -677,6 +1831,33 @@ public:
     });
   }
 
+  /* Releases the memory not needed by the current contents and iterators:
+   * excess capacity (as shrink_to_fit), epochs held for reuse that nothing
+   * else refers to, epochs that can be fused away and the nodes in the
+   * current thread's epoch cache. Meant for memory-pressure handlers (see
+   * <semistable/trim.hpp>).
+   */
+
+  void trim()
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    if(impl.capacity() != impl.size()) shrink_to_fit();
+
+    /* fuse as in make_epoch_pointer, then drop the oldest epochs held */
+
+    for(std::size_t i = 1; i + 1 < prev.size(); ) {
+      if(prev[i].use_count() == 2 && prev[i - 1].use_count() == 2 &&
+         prev[i]->try_fuse(*prev[i - 1])) {
+        prev.remove(i - 1);
+      }
+      else ++i;
+    }
+    for(auto n = prev.size(); n && prev[n - 1].use_count() == 1; --n) {
+      prev.remove(n - 1);
+    }
+    epoch_pointer::clear_cache();
+  }
+
   /* element access */
 
   reference       operator[](size_type n) { return impl[n]; }
@@ -701,7 +1882,9 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto n = impl.size();
-      impl.emplace_back(std::forward<Args>(args)...);
+      if(!emplace_grown(n, std::forward<Args>(args)...)) {
+        impl.emplace_back(std::forward<Args>(args)...);
+      }
       return epoch_type{impl.data(), n, 1};
     });
     return impl.back();
@@ -712,7 +1895,7 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto n = impl.size();
-      impl.push_back(x);
+      if(!emplace_grown(n, x)) impl.push_back(x);
       return epoch_type{impl.data(), n, 1};
     });
   }
@@ -722,7 +1905,7 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto n = impl.size();
-      impl.push_back(std::move(x));
+      if(!emplace_grown(n, std::move(x))) impl.push_back(std::move(x));
       return epoch_type{impl.data(), n, 1};
     });
   }
@@ -740,12 +1923,50 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     new_epoch([&, this] {
       auto n = impl.size();
+      reserve_grown_range(rg);
       impl.append_range(std::forward<R>(rg));
       return epoch_type{
         impl.data(), n, (difference_type)(impl.size() - n)};
     });
   }
 
+  /* Appends up to n elements written by filler(p, m), which is passed
+   * uninitialized storage for m elements at a time and returns how many of
+   * them it wrote (appending stops early if fewer than m). Unlike resize
+   * followed by overwriting, the appended elements are written only once,
+   * as filler works on a small cache-resident block that is then copied
+   * into the (reserved in advance) buffer. A single epoch is published. If
+   * filler throws, the elements already appended are kept.
+   */
+
+  template<typename Filler>
+  size_type append_uninitialized(size_type n, Filler filler)
+  {
+    static_assert(
+      std::is_trivially_default_constructible<T>::value &&
+      std::is_trivially_copyable<T>::value,
+      "T must be trivially default constructible and trivially copyable");
+    static constexpr size_type block_size =
+      sizeof(T) < 4096? 4096 / sizeof(T): 1;
+
+    SEMISTABLE_CHECK_INVARIANT;
+    size_type res = 0;
+    new_epoch([&, this] {
+      auto m = impl.size();
+      if(n > impl.capacity() - m) impl.reserve(grown_capacity(n));
+      T block[block_size];
+      while(res < n) {
+        size_type k = (std::min)(n - res, block_size),
+                  written = (std::min)((size_type)filler(block, k), k);
+        impl.insert(impl.end(), block, block + written);
+        res += written;
+        if(written < k) break;
+      }
+      return epoch_type{impl.data(), m, (difference_type)res};
+    });
+    return res;
+  }
+
   void pop_back()
   {
     SEMISTABLE_CHECK_INVARIANT;
@@ -762,7 +1983,11 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     auto index = pos.index();
     new_epoch([&, this] {
-      impl.emplace(impl.begin() + index, std::forward<Args>(args)...);
+      if(!emplace_grown(index, std::forward<Args>(args)...)) {
+        emplace_impl(
+          index, detail::needs_emplacement_buffer<T, Args&&...>{},
+          std::forward<Args>(args)...);
+      }
       return epoch_type{impl.data(), index, 1};
     });
     return {index, pe};
@@ -773,7 +1998,10 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     auto index = pos.index();
     new_epoch([&, this] {
-      impl.insert(impl.begin() + index, x);
+      if(!emplace_grown(index, x)) {
+        emplace_impl(
+          index, detail::needs_emplacement_buffer<T, const T&>{}, x);
+      }
       return epoch_type{impl.data(), index, 1};
     });
     return {index, pe};
@@ -784,7 +2012,9 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     auto index = pos.index();
     new_epoch([&, this] {
-      impl.insert(impl.begin() + index, std::move(x));
+      if(!emplace_grown(index, std::move(x))) {
+        impl.insert(impl.begin() + index, std::move(x));
+      }
       return epoch_type{impl.data(), index, 1};
     });
     return {index, pe};
@@ -795,7 +2025,22 @@ public:
     SEMISTABLE_CHECK_INVARIANT;
     auto index = pos.index();
     new_epoch([&, this] {
-      impl.insert(impl.begin() + index, n, x);
+      auto insert_n = [&, this] (const T& y) {
+        insert_impl(
+          index,
+          [&, this] { impl.insert(impl.begin() + index, n, y); },
+          [&, this] { return impl_type{n, y, impl.get_allocator()}; },
+          detail::needs_range_insertion_buffer<T, const T*>{});
+      };
+
+      if(grows_with_hint(n)) {
+        /* x may be an element, hence the temporary */
+
+        detail::temporary_value<T, Allocator> tmp{impl.get_allocator(), x};
+        impl.reserve(grown_capacity(n));
+        insert_n(*tmp.get());
+      }
+      else insert_n(x);
       return epoch_type{impl.data(), index, (difference_type)n};
     });
     return {index, pe};
@@ -816,7 +2061,14 @@ public:
     auto index = pos.index();
     new_epoch([&, this] {
       auto m = impl.size();
-      impl.insert(impl.begin() + index, first, last);
+      reserve_grown(
+        first, last,
+        typename std::iterator_traits<InputIterator>::iterator_category{});
+      insert_impl(
+        index,
+        [&, this] { impl.insert(impl.begin() + index, first, last); },
+        [&, this] { return impl_type{first, last, impl.get_allocator()}; },
+        detail::needs_range_insertion_buffer<T, InputIterator>{});
       return epoch_type{
         impl.data(), index, (difference_type)(impl.size() - m)};
     });
@@ -839,7 +2091,19 @@ public:
     auto index = pos.index();
     new_epoch([&, this] {
       auto m = impl.size();
-      impl.insert_range(impl.begin() + index, std::forward<R>(rg));
+      reserve_grown_range(rg);
+      insert_impl(
+        index,
+        [&, this] {
+          impl.insert_range(impl.begin() + index, std::forward<R>(rg));
+        },
+        [&, this] {
+          impl_type buf{impl.get_allocator()};
+          buf.insert_range(buf.end(), std::forward<R>(rg));
+          return buf;
+        },
+        detail::needs_range_insertion_buffer<
+          T, decltype(std::begin(std::declval<R&>()))>{});
       return epoch_type{
         impl.data(), index, (difference_type)(impl.size() - m)};
     });
@@ -862,6 +2126,40 @@ public:
     return {index, pe};
   }
 
+  /* Erases the element at pos by moving the last element into its place,
+   * in O(1). Iterators to the last element follow it to pos, which is
+   * returned (or end() if pos was the last element). Scan cursors and range
+   * markers see the relocated element as erased.
+   */
+
+  iterator erase_unordered(const_iterator pos)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    auto index = pos.index();
+    erase_unordered_impl(index);
+    return {index, pe};
+  }
+
+  /* Erases the elements satisfying pred as with erase_unordered, which
+   * publishes an epoch per erased element. pred is evaluated once on each
+   * element, including those moved into the place of erased ones.
+   */
+
+  template<typename Predicate>
+  size_type erase_unordered_if(Predicate pred)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    size_type res = 0;
+    for(size_type index = 0; index < impl.size(); ) {
+      if(pred(impl[index])) {
+        erase_unordered_impl(index);
+        ++res;
+      }
+      else ++index;
+    }
+    return res;
+  }
+
   iterator erase(const_iterator first, const_iterator last)
   {
     SEMISTABLE_CHECK_INVARIANT;
@@ -870,11 +2168,43 @@ public:
     new_epoch([&, this] {
       impl.erase(impl.begin() + findex, impl.begin() + lindex);
       return epoch_type{
-        impl.data(), findex + 1, (difference_type)(findex - lindex)};
+        impl.data(), lindex, (difference_type)(findex - lindex)};
     });
     return {findex, pe};
   }
 
+  /* Takes over the buffer of x, in O(1) if allocators are equal or
+   * propagate on move assignment. As with assign, outstanding iterators to
+   * positions still in range stay dereferenceable.
+   */
+
+  void adopt(std::vector<T, Allocator>&& x)
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    new_epoch([&, this] {
+      auto n = impl.size();
+      impl = std::move(x);
+      return epoch_type{impl.data(), n, (difference_type)(impl.size() - n)};
+    });
+  }
+
+  /* Hands over the buffer in O(1) and leaves the vector empty, publishing
+   * the same epoch as clear(): outstanding end() iterators stay equal to
+   * end() and no iterator is left pointing into the released buffer.
+   */
+
+  std::vector<T, Allocator> release()
+  {
+    SEMISTABLE_CHECK_INVARIANT;
+    impl_type res{impl.get_allocator()};
+    new_epoch([&, this] {
+      auto n = impl.size();
+      res.swap(impl);
+      return epoch_type{impl.data(), n, -(difference_type)n};
+    });
+    return res;
+  }
+
   void swap(vector& x)
 #if !defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
     noexcept(noexcept(
@@ -885,8 +2215,7 @@ public:
     SEMISTABLE_CHECK_INVARIANT_OF(x);
     impl.swap(x.impl);
     pe.swap(x.pe);
-    pe1.swap(x.pe1);
-    pe2.swap(x.pe2);
+    prev.swap(x.prev);
   }
 
   void clear()
@@ -910,7 +2239,7 @@ private:
 #endif
     :    
     impl{std::move(x.impl)},
-    pe{std::move(x.pe)}, pe1{std::move(x.pe1)}, pe2{std::move(x.pe2)}
+    pe{std::move(x.pe)}, prev{std::move(x.prev)}
   {
     SEMISTABLE_CHECK_INVARIANT_OF(*this);
     SEMISTABLE_CHECK_INVARIANT_OF(x);
@@ -921,13 +2250,13 @@ private:
   vector(
     vector&& x, const Allocator& al,
     epoch_pointer pe_for_x, size_type x_size, epoch_pointer pe_for_this):
-    impl{std::move(x.impl), al}, pe{}, pe1{}, pe2{}
+    impl{std::move(x.impl), al}, pe{}, prev{}
   {
-    // TODO: make safe against exceptions in impl construction
+    /* if impl construction throws, x.impl keeps its buffer and size, so
+     * x's epochs are still accurate */
     if(!pe_for_this) { /* equal allocators */
       pe = std::move(x.pe);
-      pe1 = std::move(x.pe1);
-      pe2 = std::move(x.pe2);
+      prev = std::move(x.prev);
       x.pe = std::move(pe_for_x);
       *x.pe = {x.impl.data()};
     }
@@ -949,50 +2278,300 @@ private:
     new_epoch(make_epoch_pointer(), f);
   }
 
+  /* f modifies impl and returns the epoch describing the change, which is
+   * published only if f succeeds. Modifiers provide the strong guarantee
+   * whenever T's moves don't throw, so the prepared epoch can then be simply
+   * dropped on exception.
+   */
+
   template<typename F>
   void new_epoch(epoch_pointer&& next, F f) noexcept(noexcept(f()))
   {
-    *next = f();
-    pe->next = next;
-    pe2 = std::move(pe1);
-    pe1 = std::move(pe);
-    pe = std::move(next);
+    epoch_transaction t{*this, std::move(next)};
+    t.commit(f());
   }
 
-  epoch_pointer make_epoch_pointer()
+  struct epoch_transaction
+  {
+    epoch_transaction(vector& x_, epoch_pointer&& next_) noexcept:
+      x{x_}, next{std::move(next_)},
+      data{x.impl.data()}, size{x.impl.size()} {}
+
+    ~epoch_transaction()
+    {
+      if(next && (x.impl.data() != data || x.impl.size() != size)) {
+        /* impl partially modified (T's moves throw): keep iterators in the
+         * current buffer, even if element positions are unspecified.
+         */
+
+        commit(epoch_type{
+          x.impl.data(), size, (difference_type)(x.impl.size() - size)});
+      }
+    }
+
+    void commit(const epoch_type& e) noexcept
+    {
+      SEMISTABLE_PROBE2(epoch_publish, e.index, e.offset);
+      *next = e;
+
+      /* skip link from an epoch held up to four hops behind */
+
+      if(auto n = (std::min)(x.prev.size(), (std::size_t)3)) {
+        x.prev[n - 1]->ahead =
+          detail::to_pointer<epoch_node_pointer>(next.get());
+      }
+      x.pe->next = next;
+      x.prev.push(std::move(x.pe));
+      x.pe = std::move(next);
+    }
+
+    vector&       x;
+    epoch_pointer next;
+    const T*      data;
+    size_type     size;
+  };
+
+  void erase_unordered_impl(size_type index)
+  {
+    new_epoch([&, this] {
+      auto last = impl.size() - 1;
+      if(index == last) {
+        impl.pop_back();
+        return epoch_type{impl.data(), last + 1, -1};
+      }
+      impl[index] = std::move(impl.back());
+      impl.pop_back();
+      return epoch_type{impl.data(), last + 1, -1, index};
+    });
+  }
+
+  template<typename... Args>
+  void emplace_impl(size_type index, std::false_type, Args&&... args)
+  {
+    impl.emplace(impl.begin() + index, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  void emplace_impl(size_type index, std::true_type, Args&&... args)
+  {
+    if(index == impl.size()) { /* strong guarantee at the end */
+      impl.emplace_back(std::forward<Args>(args)...);
+    }
+    else {
+      detail::temporary_value<T, Allocator> tmp{
+        impl.get_allocator(), std::forward<Args>(args)...};
+      impl.emplace(impl.begin() + index, std::move(*tmp.get()));
+    }
+  }
+
+  /* Capacity to grow to so that n more elements fit: geometric growth,
+   * capped at max_size() as long as the n elements fit below it (as with
+   * std::vector), and rounded up to the size the allocator actually
+   * provides if it tells (see detail::has_allocation_size).
+   */
+
+  size_type grown_capacity(size_type n) const
+  {
+    auto m = impl.size(),
+         c = (std::max)(m + n, (std::min)(m + (std::max)(n, m), max_size()));
+    return allocation_size(c, detail::has_allocation_size<Allocator>{});
+  }
+
+  size_type allocation_size(size_type n, std::false_type) const
+  {
+    return n;
+  }
+
+  size_type allocation_size(size_type n, std::true_type) const
+  {
+    size_type m = impl.get_allocator().allocation_size(n);
+    return (std::max)(n, (std::min)(m, max_size()));
+  }
+
+  /* std::vector grows by its own rule, ignoring allocator size hints:
+   * before inserting n elements that don't fit, we reserve the hinted
+   * capacity. Insertions of elements from the vector itself copy them first
+   * (ranges are required not to overlap with the vector).
+   */
+
+  bool grows_with_hint(size_type n) const noexcept
+  {
+    return
+      detail::has_allocation_size<Allocator>::value &&
+      n > impl.capacity() - impl.size();
+  }
+
+  void reserve_grown(size_type n)
+  {
+    if(grows_with_hint(n)) impl.reserve(grown_capacity(n));
+  }
+
+  template<typename InputIterator>
+  void reserve_grown(InputIterator, InputIterator, std::input_iterator_tag)
+  {
+  }
+
+  template<typename ForwardIterator>
+  void reserve_grown(
+    ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+  {
+    if(detail::has_allocation_size<Allocator>::value) {
+      reserve_grown((size_type)std::distance(first, last));
+    }
+  }
+
+  template<typename R>
+  void reserve_grown_range(R& rg)
+  {
+#if !defined(BOOST_NO_CXX20_HDR_CONCEPTS) && \
+    !defined(SEMISTABLE_NO_CXX20_HDR_RANGES)
+    if constexpr(
+      std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+      if(detail::has_allocation_size<Allocator>::value) {
+        reserve_grown((size_type)std::ranges::distance(rg));
+      }
+    }
+#else
+    (void)rg;
+#endif
+  }
+
+  /* Single-element counterpart: args may refer to elements of the vector,
+   * hence the temporary. Returns false, with args untouched, if there's no
+   * growth or the allocator gives no hints.
+   */
+
+  template<typename... Args>
+  bool emplace_grown_impl(size_type, std::false_type, Args&&...)
+  {
+    return false;
+  }
+
+  template<typename... Args>
+  bool emplace_grown_impl(size_type index, std::true_type, Args&&... args)
+  {
+    if(impl.size() < impl.capacity()) return false;
+
+    detail::temporary_value<T, Allocator> tmp{
+      impl.get_allocator(), std::forward<Args>(args)...};
+    impl.reserve(grown_capacity(1));
+    impl.emplace(impl.begin() + index, std::move(*tmp.get()));
+    return true;
+  }
+
+  template<typename... Args>
+  bool emplace_grown(size_type index, Args&&... args)
+  {
+    return emplace_grown_impl(
+      index, detail::has_allocation_size<Allocator>{},
+      std::forward<Args>(args)...);
+  }
+
+  template<typename Insert, typename MakeBuffer>
+  void insert_impl(size_type, Insert insert, MakeBuffer, std::false_type)
+  {
+    insert();
+  }
+
+  template<typename Insert, typename MakeBuffer>
+  void insert_impl(
+    size_type index, Insert, MakeBuffer make_buffer, std::true_type)
+  {
+    auto buf = make_buffer();
+    impl.insert(
+      impl.begin() + index,
+      std::make_move_iterator(buf.begin()), std::make_move_iterator(buf.end()));
+  }
+
+  template<typename InputIterator>
+  void assign_impl(
+    InputIterator first, InputIterator last, std::input_iterator_tag)
+  {
+    impl_type buf{first, last, impl.get_allocator()};
+    impl.swap(buf);
+  }
+
+  template<typename ForwardIterator>
+  void assign_impl(
+    ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
   {
-    long pe2c, pe1c;
+    /* no reallocation and nothing else throwing */
 
-    if((pe2c = pe2.use_count()) == 1) {
-      /* pe2 available for reuse */
-      return std::move(pe2);
+    if((size_type)std::distance(first, last) <= impl.capacity() &&
+       detail::is_nothrow_insertable_from<T, ForwardIterator>::value) {
+      impl.assign(first, last);
     }
-    else if((pe1c = pe1.use_count()) == 1) {
-      /* pe2 empty, pe1 available for reuse */
-      return std::move(pe1);
+    else assign_impl(first, last, std::input_iterator_tag{});
+  }
+
+  void copy_assign_impl(const vector& x, std::true_type)
+  {
+    /* allocator propagation precludes the strong guarantee */
+
+    impl = x.impl;
+  }
+
+  void copy_assign_impl(const vector& x, std::false_type)
+  {
+    assign_impl(x.impl.begin(), x.impl.end(), std::forward_iterator_tag{});
+  }
+
+  epoch_pointer make_epoch_pointer()
+  {
+    auto n = prev.size();
+
+    if(n && prev[n - 1].use_count() == 1) {
+      /* oldest epoch held not referred to by anything else, reuse it */
+      SEMISTABLE_PROBE1(epoch_reuse, n);
+      return prev.remove(n - 1);
     }
-    else if(pe2c == 2 && pe1c == 2 && pe2->try_fuse(*pe1)) {
-      /*  no iterator at *pe2 or *pe1 and we can fuse *pe1 into *pe2 */
-      auto tmp = std::move(pe1);
-      pe1 = std::move(pe2);
-      return std::move(tmp); // TODO: does this prevent copy elision?
+
+    /* If there's no iterator at *prev[i] or *prev[i - 1] and we can fuse
+     * *prev[i - 1] into *prev[i], the former is freed up: we need to hold
+     * *prev[i + 1] to know that the second reference to *prev[i] is
+     * prev[i + 1]->next, as otherwise *prev[i] could be the oldest epoch in
+     * the chain and the reference be from an iterator. Fusing within runs of
+     * consecutive epochs with no iterators keeps the chain from growing
+     * between lagging iterators.
+     */
+
+    for(std::size_t i = 1; i + 1 < n; ++i) {
+      if(prev[i].use_count() == 2 && prev[i - 1].use_count() == 2 &&
+         prev[i]->try_fuse(*prev[i - 1])) {
+        SEMISTABLE_PROBE(epoch_fuse);
+        return prev.remove(i - 1);
+      }
     }
-    return std::make_shared<epoch_type>();
+    SEMISTABLE_PROBE(epoch_allocate);
+    return epoch_pointer::allocate(impl.get_allocator());
   }
 
 #if defined(SEMISTABLE_ENABLE_INVARIANT_CHECKING)
   bool check_invariant() const noexcept
   {
     return
-      pe && pe->data == impl.data() && !pe->next &&
-      (!pe1 || pe1->next == pe) &&
-      (!pe2 || (pe1 && pe2->next == pe1));
+      pe && detail::data_cast<const T>(pe->data) == impl.data() &&
+      !pe->next &&
+      impl.size() <= max_size() && check_history();
+  }
+
+  bool check_history() const noexcept
+  {
+    auto n = prev.size();
+    for(std::size_t i = 0; i < prev.capacity; ++i) {
+      if(i < n? prev[i]->next != (i? prev[i - 1]: pe): (bool)prev[i]) {
+        return false;
+      }
+    }
+    return true;
   }
 #endif
   
-  impl_type     impl;
-  epoch_pointer pe = std::make_shared<epoch_type>(epoch_type{impl.data()}),
-                pe1, pe2; /* pointers to two epochs prior */
+  impl_type                        impl;
+  epoch_pointer                    pe = epoch_pointer::allocate(
+                                     impl.get_allocator(),
+                                     epoch_type{impl.data()});
+  detail::epoch_history<epoch_allocator> prev; /* epochs prior to *pe */
 };
 
 #if !defined(BOOST_NO_CXX17_DEDUCTION_GUIDES)
@@ -1067,6 +2646,24 @@ void swap(vector<T, Allocator>& x, vector<T, Allocator>& y)
 
 /* erasure */
 
+namespace detail {
+
+template<typename Impl>
+struct gap_eraser
+{
+  ~gap_eraser()
+  {
+    if(active) impl.erase(first, gap_last);
+  }
+
+  Impl&                    impl;
+  typename Impl::iterator& first;
+  typename Impl::iterator& gap_last;
+  bool                     active;
+};
+
+} /* namespace detail */
+
 template<typename T, typename Allocator, typename Predicate>
 typename vector<T, Allocator>::size_type
 erase_if(vector<T, Allocator>& x, Predicate pred)
@@ -1079,6 +2676,16 @@ erase_if(vector<T, Allocator>& x, Predicate pred)
   SEMISTABLE_CHECK_INVARIANT_OF(x);
   auto first = x.impl.begin(), last = x.impl.end();
   while(first != last && !pred(*first)) ++first;
+
+  /* As described by the epochs published so far, x consists of
+   * [begin, first) and [gap_last, last), so the gap in between must be
+   * erased also if pred or an element move throws.
+   */
+
+  auto gap_last = first;
+  detail::gap_eraser<typename vector_type::impl_type> g{
+    x.impl, first, gap_last,
+    std::is_nothrow_move_assignable<T>::value};
   if(first != last) {
     auto it = first;
     do {
@@ -1086,11 +2693,16 @@ erase_if(vector<T, Allocator>& x, Predicate pred)
       difference_type offset = 1;
       while(++it != last && pred(*it)) ++offset;
       x.new_epoch([&] {
-        while(it != last && !pred(*it)) *first++ = std::move(*it++);
         return epoch_type{x.impl.data(), index + offset, -offset};
       });
+      gap_last = it;
+      while(it != last && !pred(*it)) {
+        *first++ = std::move(*it++);
+        gap_last = it;
+      }
     } while(it != last);
   }
+  g.active = false;
   size_type s = x.impl.size();
   x.impl.erase(first, last);
   return s - x.impl.size();
@@ -0,0 +1,69 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <semistable/aligned_allocator.hpp>
+#include <utility>
+
+template<std::size_t Alignment, typename T>
+bool is_aligned(const T* p)
+{
+  return (std::uintptr_t)p % Alignment == 0;
+}
+
+template<typename T, std::size_t Alignment>
+void test()
+{
+  using vector = semistable::vector<
+    T, semistable::aligned_allocator<T, Alignment>>;
+
+  vector x;
+  auto   it = x.end();
+  for(int i = 0; i < 1000; ++i) {
+    x.push_back((T)i);
+    BOOST_TEST(is_aligned<Alignment>(x.data()));
+  }
+  BOOST_TEST(it == x.begin() + 1000);
+  BOOST_TEST(is_aligned<Alignment>(it.raw() - 1000));
+
+  x.erase(x.begin() + 10, x.end());
+  x.shrink_to_fit();
+  BOOST_TEST(is_aligned<Alignment>(x.data()));
+  BOOST_TEST(it == x.end());
+
+  vector y{x};
+  BOOST_TEST(is_aligned<Alignment>(y.data()));
+  BOOST_TEST(y == x);
+
+  vector z{std::move(y)};
+  BOOST_TEST(is_aligned<Alignment>(z.data()));
+  y = z;
+  BOOST_TEST(is_aligned<Alignment>(y.data()));
+
+  T* p = semistable::aligned_data(x);
+  BOOST_TEST_EQ(p, x.data());
+  T  s = 0;
+  for(std::size_t i = 0; i < x.size(); ++i) s += p[i];
+  BOOST_TEST_EQ(s, (T)45);
+
+  const vector& cx = x;
+  BOOST_TEST_EQ(semistable::aligned_data(cx), cx.data());
+}
+
+int main()
+{
+  test<float, 64>();
+  test<double, 32>();
+  test<char, 128>();
+  test<long double, 1>(); /* alignof(T) at least */
+  return boost::report_errors();
+}
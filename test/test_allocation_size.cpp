@@ -0,0 +1,211 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <memory>
+#include <semistable/vector.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* rounds allocations up to multiples of 16 elements, as size classes do */
+
+template<typename T>
+struct size_class_allocator
+{
+  using value_type = T;
+
+  size_class_allocator() = default;
+  template<typename U>
+  size_class_allocator(const size_class_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) { return std::allocator<T>{}.allocate(n); }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  std::size_t allocation_size(std::size_t n) const noexcept
+  {
+    return (n + 15) / 16 * 16;
+  }
+
+  bool operator==(const size_class_allocator&) const noexcept
+  {
+    return true;
+  }
+
+  bool operator!=(const size_class_allocator&) const noexcept
+  {
+    return false;
+  }
+};
+
+template<typename T>
+using vector = semistable::vector<T, size_class_allocator<T>>;
+
+static_assert(
+  semistable::detail::has_allocation_size<size_class_allocator<int>>::value,
+  "size_class_allocator gives size hints");
+static_assert(
+  !semistable::detail::has_allocation_size<std::allocator<int>>::value,
+  "std::allocator gives no size hints");
+
+void test_growth()
+{
+  vector<int> x;
+  auto        it = x.end();
+  std::size_t reallocations = 0;
+  for(int i = 0; i < 1000; ++i) {
+    auto c = x.capacity();
+    if(i % 2 == 0) x.push_back(i);
+    else x.emplace_back(i);
+    if(x.capacity() != c) {
+      ++reallocations;
+      BOOST_TEST_EQ(x.capacity() % 16, 0u);
+    }
+    if(i == 0) it = x.begin();
+  }
+  BOOST_TEST_EQ(*it, 0);
+  BOOST_TEST_LE(reallocations, 7u); /* 16, 32, ..., 1024 */
+
+  vector<int> y;
+  y.resize(17);
+  BOOST_TEST_EQ(y.capacity(), 32u);
+  y.resize(40);
+  BOOST_TEST_EQ(y.capacity(), 48u);
+
+  y.append_uninitialized(8, [](int* p, std::size_t m) {
+    for(std::size_t i = 0; i < m; ++i) p[i] = (int)i;
+    return m;
+  });
+  BOOST_TEST_EQ(y.capacity(), 48u);
+  y.append_uninitialized(1, [](int* p, std::size_t) { *p = 0; return 1; });
+  BOOST_TEST_EQ(y.capacity(), 96u);
+
+  /* insertions of several elements round up as well */
+
+  vector<int> z;
+  z.resize(17, 1);
+  BOOST_TEST_EQ(z.capacity(), 32u);
+  z.insert(z.begin(), 20, 2);
+  BOOST_TEST_EQ(z.capacity(), 48u);
+  std::vector<int> rng(22, 3);
+  z.insert(z.begin() + 1, rng.begin(), rng.end());
+  BOOST_TEST_EQ(z.capacity(), 80u);
+  z.insert(z.end(), rng.begin(), rng.begin() + 21);
+  BOOST_TEST_EQ(z.capacity(), 80u);
+  z.insert(z.end(), {4});
+  BOOST_TEST_EQ(z.capacity(), 160u);
+  BOOST_TEST_EQ(z.size(), 81u);
+}
+
+void test_aliasing()
+{
+  /* arguments referring to elements survive reallocation */
+
+  vector<std::string> x;
+  x.push_back("0123456789abcdefghij");
+  x.resize(16, x.front());
+  BOOST_TEST_EQ(x.size(), x.capacity());
+
+  x.push_back(x.front());
+  BOOST_TEST_EQ(x.capacity(), 32u);
+  BOOST_TEST_EQ(x.back(), x.front());
+
+  x.resize(32, x.front());
+  auto it = x.begin() + 31;
+  x.insert(x.begin() + 1, x.back());
+  BOOST_TEST_EQ(x.capacity(), 64u);
+  BOOST_TEST_EQ(x[1], x.front());
+  BOOST_TEST(it == x.begin() + 32);
+
+  x.resize(64, x.front());
+  x.emplace(x.begin(), x[63], 10);
+  BOOST_TEST_EQ(x.capacity(), 128u);
+  BOOST_TEST_EQ(x.front(), "abcdefghij");
+
+  x.resize(128);
+  x.insert(x.begin(), std::move(x[1]));
+  BOOST_TEST_EQ(x.capacity(), 256u);
+  BOOST_TEST_EQ(x.front(), "0123456789abcdefghij");
+
+  x.insert(x.begin() + 1, 128, x.front());
+  BOOST_TEST_EQ(x.capacity(), 272u);
+  BOOST_TEST_EQ(x[128], "0123456789abcdefghij");
+}
+
+/* caps max_size() at 100 elements, without and with size hints */
+
+template<typename T>
+struct small_allocator
+{
+  using value_type = T;
+
+  small_allocator() = default;
+  template<typename U>
+  small_allocator(const small_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) { return std::allocator<T>{}.allocate(n); }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  std::size_t max_size() const noexcept { return 100; }
+
+  bool operator==(const small_allocator&) const noexcept { return true; }
+  bool operator!=(const small_allocator&) const noexcept { return false; }
+};
+
+template<typename T>
+struct small_size_class_allocator: size_class_allocator<T>
+{
+  small_size_class_allocator() = default;
+  template<typename U>
+  small_size_class_allocator(const small_size_class_allocator<U>&) noexcept
+  {}
+
+  std::size_t max_size() const noexcept { return 100; }
+};
+
+template<typename Allocator>
+void test_max_size()
+{
+  /* growth stops at max_size() rather than overshooting it */
+
+  semistable::vector<int, Allocator> x;
+  BOOST_TEST_EQ(x.max_size(), 100u);
+  x.resize(60);
+  x.shrink_to_fit();
+  auto fill = [](int* p, std::size_t m) {
+    for(std::size_t i = 0; i < m; ++i) p[i] = (int)i;
+    return m;
+  };
+  BOOST_TEST_EQ(x.append_uninitialized(30, fill), 30u);
+  BOOST_TEST_EQ(x.size(), 90u);
+  BOOST_TEST_EQ(x.capacity(), 100u);
+  x.push_back(0);
+  x.insert(x.begin(), 9, 0);
+  BOOST_TEST_EQ(x.size(), 100u);
+  BOOST_TEST_THROWS(x.push_back(0), std::length_error);
+}
+
+int main()
+{
+  test_growth();
+  test_aliasing();
+  test_max_size<small_allocator<int>>();
+  test_max_size<small_size_class_allocator<int>>();
+  return boost::report_errors();
+}
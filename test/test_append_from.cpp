@@ -0,0 +1,96 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <semistable/append_from.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct record
+{
+  int    id;
+  double value;
+};
+
+std::vector<record> make_records(std::size_t n)
+{
+  std::vector<record> res;
+  for(std::size_t i = 0; i < n; ++i) res.push_back({(int)i, (double)i / 2});
+  return res;
+}
+
+bool equal(const semistable::vector<record>& x, const record* p)
+{
+  for(const auto& r: x) {
+    if(r.id != p->id || r.value != p->value) return false;
+    ++p;
+  }
+  return true;
+}
+
+void test_istream()
+{
+  auto        rs = make_records(2000);
+  std::string bytes(
+    reinterpret_cast<const char*>(rs.data()), rs.size() * sizeof(record));
+  bytes += "xyz"; /* trailing partial record */
+
+  std::istringstream         is{bytes};
+  semistable::vector<record> x{rs.begin(), rs.begin() + 10};
+  auto                       it = x.begin() + 5;
+
+  BOOST_TEST_EQ(semistable::append_from(x, is, 1000), 1000u);
+  BOOST_TEST_EQ(x.size(), 1010u);
+  BOOST_TEST_EQ(x[10].id, 0);
+  BOOST_TEST_EQ(x[1009].id, 999);
+  BOOST_TEST_EQ(it->id, 5);
+
+  BOOST_TEST_EQ(semistable::append_from(x, is, 5000), 1000u);
+  BOOST_TEST_EQ(x.size(), 2010u);
+  BOOST_TEST_EQ(x.back().id, 1999);
+  BOOST_TEST_EQ(semistable::append_from(x, is, 10), 0u);
+  BOOST_TEST_EQ(it->id, 5);
+}
+
+void test_fd()
+{
+#if defined(BOOST_HAS_UNISTD_H)
+  auto  rs = make_records(3000);
+  FILE* f = std::tmpfile();
+  BOOST_TEST(f != nullptr);
+  if(!f) return;
+  BOOST_TEST_EQ(
+    std::fwrite(rs.data(), sizeof(record), rs.size(), f), rs.size());
+  std::fflush(f);
+  std::rewind(f);
+
+  semistable::vector<record> x;
+  auto                       it = x.end();
+  BOOST_TEST_EQ(semistable::append_from(x, fileno(f), 100), 100u);
+  BOOST_TEST_EQ(semistable::append_from(x, fileno(f), 10000), 2900u);
+  BOOST_TEST_EQ(x.size(), rs.size());
+  BOOST_TEST(equal(x, rs.data()));
+  BOOST_TEST(it == x.end());
+  std::fclose(f);
+
+  BOOST_TEST_THROWS(semistable::append_from(x, -1, 10), std::system_error);
+  BOOST_TEST_EQ(x.size(), rs.size());
+#endif
+}
+
+int main()
+{
+  test_istream();
+  test_fd();
+  return boost::report_errors();
+}
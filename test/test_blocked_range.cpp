@@ -0,0 +1,122 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <semistable/blocked_range.hpp>
+#include <semistable/vector.hpp>
+#include <thread>
+#include <vector>
+
+using vector = semistable::vector<int>;
+using blocked_range = semistable::blocked_range<int>;
+
+struct split {}; /* stands for tbb::split */
+
+void test_split()
+{
+  vector x(10);
+  for(int i = 0; i < 10; ++i) x[i] = i;
+
+  blocked_range r{x, 3};
+  BOOST_TEST_EQ(r.size(), 10u);
+  BOOST_TEST_EQ(r.grainsize(), 3u);
+  BOOST_TEST(r.is_divisible());
+
+  blocked_range r2{r, split{}};
+  BOOST_TEST_EQ(r.size(), 5u);
+  BOOST_TEST_EQ(r2.size(), 5u);
+  BOOST_TEST(r.end() == r2.begin());
+
+  auto r3 = r2.split();
+  BOOST_TEST_EQ(r2.size(), 2u);
+  BOOST_TEST_EQ(r3.size(), 3u);
+  BOOST_TEST(!r2.is_divisible());
+  BOOST_TEST(!r3.is_divisible());
+
+  /* insertions at a split point go to the right, erasures shrink */
+
+  x.insert(x.begin() + 5, 100);
+  BOOST_TEST_EQ(r.size(), 5u);
+  BOOST_TEST_EQ(r2.size(), 3u);
+  BOOST_TEST_EQ(*r2.begin(), 100);
+  x.erase(x.begin() + 4, x.begin() + 8);
+  BOOST_TEST_EQ(r.size(), 4u);
+  BOOST_TEST_EQ(r2.size(), 0u);
+  BOOST_TEST_EQ(r3.size(), 3u);
+  BOOST_TEST_EQ(*r3.begin(), 7);
+
+  /* appending extends the last subrange */
+
+  x.push_back(10);
+  BOOST_TEST_EQ(r3.size(), 4u);
+  BOOST_TEST_EQ(r3.end()[-1], 10);
+
+  const vector&                         cx = x;
+  semistable::blocked_range<const int> cr{cx, 1, 4};
+  BOOST_TEST_EQ(cr.size(), 3u);
+  BOOST_TEST_EQ(cr.grainsize(), 1u);
+}
+
+void test_queued_across_modifications()
+{
+  static const int num_threads = 4;
+
+  vector x(10000, 1);
+  std::mt19937 gen(92748);
+
+  /* split and queue, then modify the vector before running */
+
+  std::deque<blocked_range> queue{blocked_range{x, 64}};
+  for(std::size_t i = 0; i < queue.size(); ++i) {
+    if(queue[i].is_divisible()) queue.push_back(queue[i].split());
+  }
+  for(int i = 0; i < 1000; ++i) {
+    std::size_t pos = gen() % (x.size() + 1);
+    if(gen() % 2) x.insert(x.begin() + pos, 1);
+    else if(pos < x.size()) x.erase(x.begin() + pos);
+  }
+
+  /* workers take ranges from the queue, splitting further as they go */
+
+  std::mutex mtx;
+  auto       worker = [&] {
+    for(;;) {
+      std::unique_lock<std::mutex> lck{mtx};
+      if(queue.empty()) return;
+      auto r = std::move(queue.front());
+      queue.pop_front();
+      if(r.size() > 2 * r.grainsize()) {
+        queue.push_back(r.split());
+      }
+      lck.unlock();
+      for(auto& v: r) ++v;
+    }
+  };
+  std::vector<std::thread> threads;
+  for(int i = 0; i < num_threads; ++i) threads.emplace_back(worker);
+  for(auto& t: threads) t.join();
+
+  /* every element visited exactly once */
+
+  std::size_t visited = 0;
+  for(auto v: x) visited += v == 2;
+  BOOST_TEST_EQ(visited, x.size());
+}
+
+int main()
+{
+  test_split();
+  test_queued_across_modifications();
+  return boost::report_errors();
+}
@@ -0,0 +1,246 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <semistable/circular_buffer.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using buffer = semistable::circular_buffer<int>;
+
+template<typename Buffer>
+std::vector<int> contents(const Buffer& x)
+{
+  std::vector<int> res;
+  auto             r1 = x.array_one(), r2 = x.array_two();
+  res.insert(res.end(), r1.first, r1.first + r1.second);
+  res.insert(res.end(), r2.first, r2.first + r2.second);
+  return res;
+}
+
+void test_api()
+{
+  buffer x(5);
+  BOOST_TEST(x.empty());
+  BOOST_TEST_EQ(x.capacity(), 5u);
+  for(int i = 0; i < 7; ++i) x.push_back(i);
+  BOOST_TEST(x.full());
+  BOOST_TEST_EQ(x.front(), 2);
+  BOOST_TEST_EQ(x.back(), 6);
+  BOOST_TEST_EQ(x[1], 3);
+  BOOST_TEST_EQ(x.at(4), 6);
+  BOOST_TEST_THROWS((void)x.at(5), std::out_of_range);
+  BOOST_TEST((contents(x) == std::vector<int>{2, 3, 4, 5, 6}));
+  BOOST_TEST_EQ(x.array_one().second, 3u);
+  BOOST_TEST((std::vector<int>(x.begin(), x.end()) == contents(x)));
+  BOOST_TEST(
+    (std::vector<int>(x.rbegin(), x.rend()) ==
+     std::vector<int>{6, 5, 4, 3, 2}));
+
+  buffer y{x};
+  BOOST_TEST(x == y);
+  y.pop_front();
+  y.pop_back();
+  BOOST_TEST((contents(y) == std::vector<int>{3, 4, 5}));
+  x = y;
+  BOOST_TEST(x == y);
+  y.erase(y.begin() + 1);
+  BOOST_TEST((contents(y) == std::vector<int>{3, 5}));
+  x.swap(y);
+  BOOST_TEST((contents(x) == std::vector<int>{3, 5}));
+  BOOST_TEST((contents(y) == std::vector<int>{3, 4, 5}));
+  buffer z{std::move(y)};
+  BOOST_TEST(y.empty());
+  BOOST_TEST((contents(z) == std::vector<int>{3, 4, 5}));
+  z.clear();
+  BOOST_TEST(z.empty());
+  z.push_back(1);
+  BOOST_TEST_EQ(z.front(), 1);
+
+  semistable::circular_buffer<std::string> s(2);
+  s.emplace_back(3, 'a');
+  s.push_back("b");
+  s.push_back("c");
+  BOOST_TEST_EQ(s.front(), "b");
+
+  buffer e(0);
+  e.push_back(1);
+  BOOST_TEST(e.empty());
+}
+
+void test_iterators()
+{
+  buffer x(10);
+  for(int i = 0; i < 10; ++i) x.push_back(i);
+
+  auto it0 = x.cbegin(), it5 = x.cbegin() + 5, last = x.cend();
+  auto it9 = x.begin() + 9;
+
+  /* overwritten elements are detected */
+
+  x.push_back(10);
+  x.push_back(11);
+  BOOST_TEST(!it0.valid());
+  BOOST_TEST(it5.valid());
+  BOOST_TEST_EQ(*it5, 5);
+  BOOST_TEST(last == x.cend());
+  BOOST_TEST_EQ(it5 - x.cbegin(), 3);
+
+  /* erasures and pops */
+
+  x.erase(x.begin() + 1, x.begin() + 3);
+  BOOST_TEST_EQ(*it5, 5);
+  BOOST_TEST_EQ(*it9, 9);
+  x.pop_back();
+  BOOST_TEST(last == x.cend());
+  x.pop_front();
+  BOOST_TEST_EQ(*it5, 5);
+  BOOST_TEST(it9.valid());
+  while(x.front() != 9) x.pop_front();
+  BOOST_TEST(!it5.valid());
+  BOOST_TEST(it9.valid());
+  *it9 = 90;
+  BOOST_TEST_EQ(x.front(), 90);
+
+  /* swapping invalidates */
+
+  buffer y(3);
+  y.push_back(0);
+  auto it = y.begin();
+  x.swap(y);
+  BOOST_TEST(!it.valid());
+  BOOST_TEST(!it9.valid());
+  BOOST_TEST(!last.valid());
+  BOOST_TEST_EQ(*x.begin(), 0);
+
+  buffer::const_iterator cit;
+  BOOST_TEST(!cit.valid());
+  buffer::const_iterator cit2{cit};
+  cit2 = x.cbegin();
+  BOOST_TEST(cit2.valid());
+}
+
+void test_random()
+{
+  /* random operations checked against a deque with unique values */
+
+  std::mt19937 gen(73625);
+  buffer       x(50);
+  std::deque<int> ref;
+  std::vector<std::pair<buffer::const_iterator, int>> its;
+  std::vector<bool> popped; /* overwritten or popped from the front */
+  int next_value = 0;
+
+  for(int i = 0; i < 10000; ++i) {
+    switch(gen() % 6) {
+      case 0: case 1: case 2:
+        x.push_back(next_value);
+        if(ref.size() == 50) {
+          popped[(std::size_t)ref.front()] = true;
+          ref.pop_front();
+        }
+        ref.push_back(next_value++);
+        popped.push_back(false);
+        break;
+      case 3:
+        if(!x.empty()) {
+          x.pop_front();
+          popped[(std::size_t)ref.front()] = true;
+          ref.pop_front();
+        }
+        break;
+      case 4:
+        if(!x.empty()) {
+          auto n = gen() % x.size(),
+               m = (std::min)(x.size() - n, (std::size_t)(gen() % 4));
+          x.erase(
+            x.begin() + (std::ptrdiff_t)n, x.begin() + (std::ptrdiff_t)(n + m));
+          ref.erase(
+            ref.begin() + (std::ptrdiff_t)n,
+            ref.begin() + (std::ptrdiff_t)(n + m));
+        }
+        break;
+      default:
+        if(!x.empty()) {
+          auto n = (std::ptrdiff_t)(gen() % x.size());
+          its.push_back({x.cbegin() + n, ref[(std::size_t)n]});
+        }
+        break;
+    }
+    BOOST_TEST_EQ(x.size(), ref.size());
+  }
+  BOOST_TEST((contents(x) == std::vector<int>(ref.begin(), ref.end())));
+  for(const auto& p: its) {
+    bool present = std::find(ref.begin(), ref.end(), p.second) != ref.end();
+    if(popped[(std::size_t)p.second]) BOOST_TEST(!p.first.valid());
+    if(present) {
+      BOOST_TEST(p.first.valid());
+      BOOST_TEST_EQ(*p.first, p.second);
+    }
+  }
+}
+
+struct throwing_element
+{
+  static int live;
+
+  throwing_element(int key_): key{key_} { ++live; }
+  throwing_element(throwing_element&& x): key{x.key}
+  {
+    if(x.key == 13) throw std::runtime_error("");
+    ++live;
+  }
+  ~throwing_element() { --live; }
+
+  throwing_element& operator=(throwing_element&& x)
+  {
+    if(x.key == 13) throw std::runtime_error("");
+    key = x.key;
+    return *this;
+  }
+
+  int key;
+};
+
+int throwing_element::live = 0;
+
+void test_exceptions()
+{
+  {
+    semistable::circular_buffer<throwing_element> x(3);
+    for(int i = 0; i < 5; ++i) x.emplace_back(i);
+
+    /* overwriting the oldest element leaves it alive if the move throws */
+
+    BOOST_TEST_THROWS(x.emplace_back(13), std::runtime_error);
+    BOOST_TEST_EQ(x.size(), 3u);
+    BOOST_TEST_EQ(throwing_element::live, 3);
+    x.emplace_back(5);
+    BOOST_TEST_EQ(x.front().key, 3);
+    BOOST_TEST_EQ(x.back().key, 5);
+  }
+  BOOST_TEST_EQ(throwing_element::live, 0);
+}
+
+int main()
+{
+  test_api();
+  test_iterators();
+  test_random();
+  test_exceptions();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,16 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/* test_stability.cpp with 32-bit epoch shifts */
+
+#define SEMISTABLE_COMPACT_EPOCHS
+#include "test_stability.cpp"
+
+/* shifts as large as the size fit in the 32-bit signed offset */
+
+static_assert(
+  semistable::detail::epoch_shift::max_size == 0x7FFFFFFFu,
+  "max_size() is 2^31 - 1 with compact epochs");
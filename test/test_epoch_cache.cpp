@@ -0,0 +1,131 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <semistable/vector.hpp>
+#include <thread>
+#include <vector>
+
+std::size_t num_allocations = 0;
+
+void* operator new(std::size_t n)
+{
+  ++num_allocations;
+  if(void* p = std::malloc(n? n: 1)) return p;
+  throw std::bad_alloc();
+}
+
+/* all forms replaced so that deallocations match allocations */
+
+void* operator new[](std::size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+/* freed after the main thread's cache is closed */
+
+semistable::vector<int> global_x(10);
+auto                    global_it = global_x.begin() + 5;
+
+template<typename T>
+void short_lived()
+{
+  semistable::vector<T> x(10);
+  auto                  it = x.begin() + 5;
+  x.erase(x.begin());
+  BOOST_TEST(it == x.begin() + 4);
+}
+
+void test_reuse()
+{
+  /* warm up the cache */
+
+  short_lived<int>();
+
+  /* epochs come from the cache, the only allocation is the buffer, and
+   * vectors of different element types share the nodes
+   */
+
+  auto n = num_allocations;
+  for(int i = 0; i < 100; ++i) {
+    short_lived<int>();
+    short_lived<double>();
+  }
+#if defined(SEMISTABLE_NO_EPOCH_CACHE)
+  BOOST_TEST_EQ(num_allocations - n, 600u);
+#else
+  BOOST_TEST_EQ(num_allocations - n, 200u);
+#endif
+}
+
+void test_bounded()
+{
+  /* A long chain freed at once doesn't grow the cache beyond its capacity,
+   * so building it again allocates most of its epochs. Relocations don't
+   * fuse, so each modification adds an epoch to the chain.
+   */
+
+  auto build_chain = [] {
+    std::size_t             size = 10 * SEMISTABLE_EPOCH_CACHE_SIZE;
+    semistable::vector<int> x(size, 0);
+    auto                    it = x.begin() + 1;
+    *it = 1;
+    for(std::size_t i = 0; i < size; ++i) {
+      x.insert(x.begin(), 0);
+      x.erase_unordered(x.begin());
+    }
+    BOOST_TEST_EQ(*it, 1);
+    return size * 2;
+  };
+
+  build_chain();
+  auto n = num_allocations;
+  auto m = build_chain();
+  BOOST_TEST_GE(num_allocations - n, m - SEMISTABLE_EPOCH_CACHE_SIZE);
+}
+
+void test_threads()
+{
+  /* epochs freed in a thread other than the one allocating them, and
+   * caches emptied on thread exit
+   */
+
+  std::vector<semistable::vector<int>> xs(8, semistable::vector<int>(10));
+  std::vector<semistable::vector<int>::iterator> its;
+  for(auto& x: xs) {
+    its.push_back(x.begin() + 5);
+    x.erase(x.begin());
+  }
+
+  std::thread t{[&] {
+    for(auto& x: xs) {
+      x.insert(x.begin(), 0);
+      short_lived<int>();
+    }
+    its.clear();
+    xs.clear();
+  }};
+  t.join();
+  short_lived<int>();
+}
+
+int main()
+{
+  test_reuse();
+  test_bounded();
+  test_threads();
+  BOOST_TEST_EQ(*global_it, 0);
+
+  return boost::report_errors();
+}
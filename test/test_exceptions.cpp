@@ -0,0 +1,196 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <ostream>
+#include <semistable/vector.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* copies throw when the countdown reaches zero, moves never throw */
+
+int countdown = 0;
+
+void tick()
+{
+  if(countdown > 0 && --countdown == 0) throw std::runtime_error("tick");
+}
+
+struct throwing
+{
+  throwing(int n_ = 0): n{n_} {}
+  throwing(const throwing& x): n{x.n} { tick(); }
+  throwing(throwing&& x) noexcept: n{x.n} {}
+
+  throwing& operator=(const throwing& x)
+  {
+    tick();
+    n = x.n;
+    return *this;
+  }
+
+  throwing& operator=(throwing&& x) noexcept
+  {
+    n = x.n;
+    return *this;
+  }
+
+  friend bool operator==(const throwing& x, const throwing& y)
+  {
+    return x.n == y.n;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const throwing& x)
+  {
+    return os << x.n;
+  }
+
+  int n;
+};
+
+static_assert(
+  !std::is_nothrow_copy_constructible<throwing>::value &&
+  std::is_nothrow_move_constructible<throwing>::value,
+  "throwing copy, nothrow move");
+
+std::vector<throwing> make_range(std::size_t n)
+{
+  std::vector<throwing> res;
+  for(int i = 0; i < (int)n; ++i) res.emplace_back(i);
+  return res;
+}
+
+/* Throws at every possible copy in f in succession and checks that, when
+ * f fails, x and its outstanding iterators are left unchanged.
+ */
+
+template<typename Vector, typename F>
+void test_strong_guarantee(Vector& x, F f)
+{
+  using const_iterator = typename Vector::const_iterator;
+  using value_type = typename Vector::value_type;
+
+  for(int n = 1; ; ++n) {
+    Vector                      y{x};
+    std::vector<value_type>     values(y.begin(), y.end());
+    std::vector<const_iterator> its;
+    for(auto it = y.cbegin(); it != y.cend(); ++it) its.push_back(it);
+    const_iterator              last = y.cend();
+
+    countdown = n;
+    bool thrown = false;
+    try {
+      f(y);
+    }
+    catch(const std::runtime_error&) {
+      thrown = true;
+    }
+    countdown = 0;
+    if(!thrown) break;
+
+    BOOST_TEST_EQ(y.size(), values.size());
+    BOOST_TEST(std::equal(y.begin(), y.end(), values.begin()));
+    for(std::size_t i = 0; i < its.size(); ++i) {
+      BOOST_TEST(its[i] == y.cbegin() + (std::ptrdiff_t)i);
+      BOOST_TEST_EQ(*its[i], values[i]);
+    }
+    BOOST_TEST(last == y.cend());
+  }
+}
+
+template<typename Vector>
+void test()
+{
+  auto rng = make_range(20);
+
+  for(std::size_t cap: {rng.size(), 2 * rng.size()}) {
+    Vector x{rng.begin(), rng.end()};
+    x.reserve(cap);
+
+    /* strong guarantee both with and without reallocation */
+
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.insert(y.begin() + 5, rng[1]);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.emplace(y.begin() + 5, rng[1]);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.insert(y.begin() + 5, 8, rng[1]);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.insert(y.begin() + 5, rng.begin(), rng.begin() + 8);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.insert(y.end(), rng.begin(), rng.begin() + 8);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.insert(y.begin() + 5, {rng[1], rng[2], rng[3]});
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.push_back(rng[1]);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.resize(y.size() + 8, rng[1]);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.assign(rng.begin(), rng.begin() + 8);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.assign(rng.begin(), rng.end());
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y.assign(8, rng[1]);
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      y = {rng[1], rng[2], rng[3]};
+    });
+    test_strong_guarantee(x, [&] (Vector& y) {
+      Vector z{rng.begin(), rng.begin() + 8};
+      y = z;
+    });
+  }
+
+  /* erase_if with throwing predicate */
+
+  for(int n = 1; n < (int)rng.size(); ++n) {
+    using const_iterator = typename Vector::const_iterator;
+
+    Vector                                      x{rng.begin(), rng.end()};
+    std::vector<std::pair<const_iterator, int>> kept;
+    for(auto it = x.cbegin(); it != x.cend(); ++it) {
+      if(it->n % 3 != 0) kept.push_back({it, it->n});
+    }
+    const_iterator last = x.cend();
+
+    int calls = 0;
+    try {
+      erase_if(x, [&] (const throwing& v) {
+        if(++calls == n) throw std::runtime_error("pred");
+        return v.n % 3 == 0;
+      });
+    }
+    catch(const std::runtime_error&) {}
+
+    for(const auto& p: kept) BOOST_TEST_EQ(p.first->n, p.second);
+    BOOST_TEST(last == x.cend());
+  }
+}
+
+int main()
+{
+  test<semistable::vector<throwing>>();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,191 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <semistable/indexed_vector.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+struct element
+{
+  int         key;
+  std::string value;
+
+  friend bool operator==(const element& x, const element& y)
+  {
+    return x.key == y.key && x.value == y.value;
+  }
+};
+
+struct key_of_element
+{
+  int operator()(const element& x) const { return x.key; }
+};
+
+using vector = semistable::indexed_vector<element, key_of_element>;
+
+/* keys are found at their elements as long as the index is consistent */
+
+void test_index(const vector& x)
+{
+  for(auto it = x.begin(); it != x.end(); ++it) {
+    BOOST_TEST(x.find(it->key) == it);
+  }
+}
+
+void test_api()
+{
+  vector x{{0, "a"}, {1, "b"}, {0, "c"}, {2, "d"}};
+  BOOST_TEST_EQ(x.size(), 3u);
+  BOOST_TEST_EQ(x[0].value, "a");
+  test_index(x);
+
+  auto p = x.push_back({1, "e"});
+  BOOST_TEST(!p.second);
+  BOOST_TEST(p.first == x.begin() + 1);
+  p = x.emplace(x.begin(), element{3, "f"});
+  BOOST_TEST(p.second);
+  BOOST_TEST(p.first == x.begin());
+  BOOST_TEST(x.contains(3));
+  BOOST_TEST_EQ(x.count(4), 0u);
+  BOOST_TEST(x.find(4) == x.end());
+  test_index(x);
+
+  BOOST_TEST_EQ(x.erase(1), 1u);
+  BOOST_TEST_EQ(x.erase(1), 0u);
+  BOOST_TEST(!x.contains(1));
+  test_index(x);
+
+  vector::reverse_iterator       rit = x.rbegin();
+  vector::const_reverse_iterator crit = x.crbegin();
+  BOOST_TEST(rit == crit);
+  BOOST_TEST_EQ(rit->value, x.back().value);
+  BOOST_TEST_EQ(x.rend() - x.rbegin(), (std::ptrdiff_t)x.size());
+  BOOST_TEST(x.crend() == x.rend());
+  BOOST_TEST_EQ((x.rend() - 1)->value, x.front().value);
+
+  vector y{x};
+  BOOST_TEST(x == y);
+  test_index(y);
+  y.pop_back();
+  BOOST_TEST(x != y);
+  x = y;
+  BOOST_TEST(x == y);
+  test_index(x);
+  x.swap(y);
+  test_index(x);
+  test_index(y);
+
+  vector z{std::move(x)};
+  test_index(z);
+  BOOST_TEST(x.empty());
+  BOOST_TEST(x.find(0) == x.end());
+  z.clear();
+  BOOST_TEST(z.empty());
+  BOOST_TEST(!z.contains(0));
+  z.emplace_back(element{0, "g"});
+  test_index(z);
+}
+
+void test_stability()
+{
+  vector x;
+  for(int i = 0; i < 1000; ++i) x.push_back({i, std::to_string(i)});
+
+  /* positions are kept by the index through insertions and erasures */
+
+  for(int i = 0; i < 1000; i += 2) x.erase(x.find(i));
+  for(int i = 1000; i < 2000; ++i) x.emplace(x.begin(), element{i, ""});
+  x.erase(x.begin() + 100, x.begin() + 600);
+  BOOST_TEST_EQ(x.size(), 1000u);
+  for(int i = 1; i < 1000; i += 2) {
+    auto it = x.find(i);
+    BOOST_TEST(it != x.end());
+    BOOST_TEST_EQ(it->value, std::to_string(i));
+  }
+  for(int i = 0; i < 1000; i += 2) BOOST_TEST(!x.contains(i));
+  test_index(x);
+
+  /* outstanding iterators are not affected */
+
+  auto it = x.find(501);
+  for(int i = 0; i < 10000; ++i) {
+    x.push_back({-1, ""});
+    x.erase(-1);
+  }
+  BOOST_TEST_EQ(it->key, 501);
+  test_index(x);
+}
+
+void test_rebuild()
+{
+  /* the index survives many rebuilds */
+
+  vector x;
+  for(int i = 0; i < 4000; ++i) x.push_back({i, ""});
+  for(int i = 3998; i >= 0; i -= 2) x.erase(i);
+  BOOST_TEST_EQ(x.size(), 2000u);
+  test_index(x);
+  for(int i = 1; i < 4000; i += 2) {
+    auto it = x.find(i);
+    BOOST_TEST(it != x.end());
+    BOOST_TEST_EQ(it->key, i);
+  }
+}
+
+struct throwing_element
+{
+  throwing_element(int key_): key{key_} {}
+  throwing_element(const throwing_element&) = default;
+
+  throwing_element& operator=(const throwing_element& x)
+  {
+    if(x.key == 13) throw std::runtime_error("");
+    key = x.key;
+    return *this;
+  }
+
+  int key;
+};
+
+struct key_of_throwing_element
+{
+  int operator()(const throwing_element& x) const { return x.key; }
+};
+
+void test_exceptions()
+{
+  using vector = semistable::indexed_vector<
+    throwing_element, key_of_throwing_element>;
+
+  vector x;
+  for(int i = 0; i < 20; ++i) x.push_back(i);
+
+  /* the index is rebuilt if erasure throws midway */
+
+  BOOST_TEST_THROWS(x.erase(x.begin() + 5, x.begin() + 10), std::runtime_error);
+  BOOST_TEST_EQ(x.size(), 20u);
+  for(const auto& e: x) {
+    auto it = x.find(e.key);
+    BOOST_TEST(it != x.end());
+    BOOST_TEST_EQ(it->key, e.key);
+  }
+}
+
+int main()
+{
+  test_api();
+  test_stability();
+  test_rebuild();
+  test_exceptions();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,188 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/config.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <cstddef>
+#include <semistable/vector.hpp>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bip = boost::interprocess;
+
+using segment_manager = bip::managed_shared_memory::segment_manager;
+using allocator = bip::allocator<int, segment_manager>;
+using vector = semistable::vector<int, allocator>;
+using const_iterator = vector::const_iterator;
+
+const std::size_t num_its = 10;
+
+std::string segment_name()
+{
+  return "semistable_vector_test_interprocess_" + std::to_string(getpid());
+}
+
+struct segment_remover
+{
+  segment_remover(const std::string& name_): name{name_}
+  {
+    bip::shared_memory_object::remove(name.c_str());
+  }
+
+  ~segment_remover() { bip::shared_memory_object::remove(name.c_str()); }
+
+  std::string name;
+};
+
+/* runs f in a child process, which maps the segment anew */
+
+template<typename F>
+void run_in_child_process(const std::string& name, F f)
+{
+  pid_t pid = fork();
+  if(pid == 0) {
+    {
+      bip::managed_shared_memory segment{bip::open_only, name.c_str()};
+      f(segment);
+    }
+    _exit(boost::report_errors());
+  }
+  BOOST_TEST_GT(pid, 0);
+  int status;
+  BOOST_TEST_EQ(waitpid(pid, &status, 0), pid);
+  BOOST_TEST(WIFEXITED(status));
+  BOOST_TEST_EQ(WEXITSTATUS(status), 0);
+}
+
+void modify(vector& x)
+{
+  /* elements 0, 10, 20... are kept */
+
+  x.insert(x.begin(), 1000, -1);
+  x.erase(x.begin() + 1000 + 1, x.begin() + 1000 + 5);
+  for(int i = 0; i < 1000; ++i) x.push_back(-1);
+  x.erase(x.begin(), x.begin() + 500);
+  x.shrink_to_fit();
+  x.insert(x.begin() + 600, 10, -1);
+}
+
+void test_iterators_in_shared_memory()
+{
+  auto                      name = segment_name();
+  segment_remover           remover{name};
+  bip::managed_shared_memory segment{bip::create_only, name.c_str(), 1 << 20};
+  auto                      free_memory = segment.get_free_memory();
+
+  auto& x = *segment.construct<vector>("x")(segment.get_segment_manager());
+  for(int i = 0; i < (int)(num_its * 10); ++i) x.push_back(i);
+  auto its = segment.construct<const_iterator>("its")[num_its]();
+  for(std::size_t i = 0; i < num_its; ++i) {
+    its[i] = x.cbegin() + (std::ptrdiff_t)(i * 10);
+  }
+  auto& last = *segment.construct<const_iterator>("last")(x.cend());
+
+  /* modifications by another process are seen through the iterators */
+
+  run_in_child_process(name, [] (bip::managed_shared_memory& segment) {
+    auto px = segment.find<vector>("x").first;
+    BOOST_TEST(px != nullptr);
+    modify(*px);
+  });
+  for(std::size_t i = 0; i < num_its; ++i) {
+    BOOST_TEST_EQ(*its[i], (int)(i * 10));
+  }
+  BOOST_TEST(last == x.cend());
+
+  /* and vice versa */
+
+  modify(x);
+  run_in_child_process(name, [] (bip::managed_shared_memory& segment) {
+    auto px = segment.find<vector>("x").first;
+    auto its = segment.find<const_iterator>("its").first;
+    auto plast = segment.find<const_iterator>("last").first;
+    for(std::size_t i = 0; i < num_its; ++i) {
+      BOOST_TEST_EQ(*its[i], (int)(i * 10));
+    }
+    BOOST_TEST(*plast == px->cend());
+  });
+
+  /* epochs are allocated in the segment and released on destruction */
+
+  segment.destroy<const_iterator>("last");
+  segment.destroy<const_iterator>("its");
+  segment.destroy<vector>("x");
+  BOOST_TEST_EQ(segment.get_free_memory(), free_memory);
+}
+
+void test_iterators_in_reader_process()
+{
+  auto                      name = segment_name();
+  segment_remover           remover{name};
+  bip::managed_shared_memory segment{bip::create_only, name.c_str(), 1 << 20};
+
+  auto& x = *segment.construct<vector>("x")(segment.get_segment_manager());
+  for(int i = 0; i < (int)(num_its * 10); ++i) x.push_back(i);
+
+  int ready[2], modified[2];
+  BOOST_TEST_EQ(pipe(ready), 0);
+  BOOST_TEST_EQ(pipe(modified), 0);
+
+  pid_t pid = fork();
+  if(pid == 0) {
+    int res = 0;
+    {
+      bip::managed_shared_memory segment{bip::open_only, name.c_str()};
+      auto&                      x = *segment.find<vector>("x").first;
+      auto                       it = x.cbegin() + 50;
+      char                       c = 0;
+
+      BOOST_TEST_EQ(write(ready[1], &c, 1), 1);
+      BOOST_TEST_EQ(read(modified[0], &c, 1), 1);
+      BOOST_TEST_EQ(*it, 50);
+      BOOST_TEST_EQ(it - x.cbegin(), 50 + 1000 - 4 - 500);
+      res = boost::report_errors();
+    }
+    _exit(res);
+  }
+
+  char c = 0;
+  BOOST_TEST_EQ(read(ready[0], &c, 1), 1);
+  modify(x);
+  BOOST_TEST_EQ(write(modified[1], &c, 1), 1);
+
+  int status;
+  BOOST_TEST_EQ(waitpid(pid, &status, 0), pid);
+  BOOST_TEST(WIFEXITED(status));
+  BOOST_TEST_EQ(WEXITSTATUS(status), 0);
+  segment.destroy<vector>("x");
+}
+
+int main()
+{
+  test_iterators_in_shared_memory();
+  test_iterators_in_reader_process();
+
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return boost::report_errors();
+}
+
+#endif
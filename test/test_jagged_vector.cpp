@@ -0,0 +1,220 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <semistable/jagged_vector.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using jagged = semistable::jagged_vector<int>;
+using reference_jagged = std::vector<std::vector<int>>;
+
+bool equal(const jagged& x, const reference_jagged& y)
+{
+  if(x.rows() != y.size()) return false;
+  std::vector<int> all;
+  for(std::size_t r = 0; r < x.rows(); ++r) {
+    auto v = x.row(r);
+    if(std::vector<int>(v.begin(), v.end()) != y[r]) return false;
+    if(std::vector<int>(x.row_begin(r), x.row_end(r)) != y[r]) return false;
+    all.insert(all.end(), y[r].begin(), y[r].end());
+  }
+  return std::vector<int>(x.begin(), x.end()) == all;
+}
+
+void test_api()
+{
+  jagged x;
+  BOOST_TEST(x.empty());
+  BOOST_TEST_EQ(x.rows(), 0u);
+
+  x.push_row({0, 1, 2});
+  x.push_row();
+  x.push_row({3, 4});
+  BOOST_TEST_EQ(x.rows(), 3u);
+  BOOST_TEST_EQ(x.size(), 5u);
+  BOOST_TEST_EQ(x.row_size(1), 0u);
+  BOOST_TEST(x[1].empty());
+  BOOST_TEST_EQ(x[2][1], 4);
+  BOOST_TEST(equal(x, {{0, 1, 2}, {}, {3, 4}}));
+
+  auto it = x.row_begin(2) + 1;
+  x.push_back(1, 10);
+  x.insert(0, x.row_begin(0), 11);
+  x.emplace_back(2, 12);
+  BOOST_TEST(equal(x, {{11, 0, 1, 2}, {10}, {3, 4, 12}}));
+  BOOST_TEST_EQ(*it, 4);
+
+  x.erase(0, x.row_begin(0), x.row_begin(0) + 2);
+  BOOST_TEST(equal(x, {{1, 2}, {10}, {3, 4, 12}}));
+  BOOST_TEST_EQ(*it, 4);
+
+  x.erase_row(1);
+  BOOST_TEST(equal(x, {{1, 2}, {3, 4, 12}}));
+  BOOST_TEST_EQ(*it, 4);
+
+  x.insert(1, x.row_end(1), 2, 5);
+  int a[] = {6, 7};
+  x.insert(0, x.row_begin(0) + 1, a, a + 2);
+  BOOST_TEST(equal(x, {{1, 6, 7, 2}, {3, 4, 12, 5, 5}}));
+  BOOST_TEST_EQ(*it, 4);
+
+  jagged y{x};
+  BOOST_TEST(x == y);
+  y.pop_row();
+  BOOST_TEST(x != y);
+  x.swap(y);
+  BOOST_TEST(equal(x, {{1, 6, 7, 2}}));
+  BOOST_TEST_EQ(*it, 4);
+  y.clear();
+  BOOST_TEST(y.empty());
+  BOOST_TEST_EQ(y.rows(), 0u);
+
+  /* moved-from jagged_vectors have no rows and can be reused */
+
+  jagged z{std::move(x)};
+  BOOST_TEST(equal(z, {{1, 6, 7, 2}}));
+  BOOST_TEST_EQ(*it, 4);
+  BOOST_TEST(x.empty());
+  BOOST_TEST_EQ(x.rows(), 0u);
+  x.push_row({8});
+  BOOST_TEST(equal(x, {{8}}));
+
+  y = std::move(x);
+  BOOST_TEST(equal(y, {{8}}));
+  BOOST_TEST_EQ(x.rows(), 0u);
+  x.push_row();
+  x.push_back(0, 9);
+  BOOST_TEST(equal(x, {{9}}));
+}
+
+void test_random()
+{
+  std::mt19937     rng;
+  jagged           x;
+  reference_jagged y;
+
+  struct tracked
+  {
+    jagged::iterator it;
+    int              value;
+  };
+  std::vector<tracked> its;
+
+  int n = 0;
+  for(int i = 0; i < 5000; ++i) {
+    auto op = rng() % 8;
+    if(op == 0 || x.rows() == 0) {
+      x.push_row();
+      y.emplace_back();
+    }
+    else {
+      std::size_t r = rng() % x.rows(), sz = x.row_size(r);
+      switch(op) {
+        case 1:
+        case 2:
+        case 3: {
+          std::size_t pos = rng() % (sz + 1);
+          auto        res = x.insert(r, x.row_begin(r) + pos, n);
+          y[r].insert(y[r].begin() + pos, n);
+          its.push_back({res, n++});
+          break;
+        }
+        case 4:
+          x.push_back(r, n);
+          y[r].push_back(n++);
+          break;
+        case 5:
+        case 6:
+          if(sz) {
+            std::size_t pos = rng() % sz;
+            auto        it = x.row_begin(r) + pos;
+            for(auto jt = its.begin(); jt != its.end(); ) {
+              if(jt->it == it) jt = its.erase(jt);
+              else ++jt;
+            }
+            x.erase(r, it);
+            y[r].erase(y[r].begin() + pos);
+          }
+          break;
+        default:
+          if(rng() % 4 == 0) {
+            auto first = x.row_begin(r), last = x.row_end(r);
+            for(auto jt = its.begin(); jt != its.end(); ) {
+              if(jt->it >= first && jt->it < last) jt = its.erase(jt);
+              else ++jt;
+            }
+            x.erase_row(r);
+            y.erase(y.begin() + r);
+          }
+          break;
+      }
+    }
+    if(i % 100 == 0) {
+      BOOST_TEST(equal(x, y));
+      for(auto& t: its) BOOST_TEST_EQ(*t.it, t.value);
+    }
+  }
+  BOOST_TEST(equal(x, y));
+  for(auto& t: its) BOOST_TEST_EQ(*t.it, t.value);
+}
+
+/* counts the allocations of row offsets */
+
+std::size_t offset_allocations = 0;
+
+template<typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() = default;
+  template<typename U>
+  counting_allocator(const counting_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n)
+  {
+    if(std::is_same<T, std::size_t>::value) ++offset_allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  bool operator==(const counting_allocator&) const noexcept { return true; }
+  bool operator!=(const counting_allocator&) const noexcept { return false; }
+};
+
+void test_bulk()
+{
+  /* offsets grow geometrically when pushing rows one at a time */
+
+  semistable::jagged_vector<int, counting_allocator<int>> x;
+  offset_allocations = 0;
+  for(int i = 0; i < 100000; ++i) x.push_row({i});
+  BOOST_TEST_EQ(x.rows(), 100000u);
+  BOOST_TEST_EQ(x.size(), 100000u);
+  BOOST_TEST_EQ(x[99999][0], 99999);
+  BOOST_TEST_LE(offset_allocations, 20u); /* 2, 4, ..., 2^17 */
+}
+
+int main()
+{
+  test_api();
+  test_random();
+  test_bulk();
+  return boost::report_errors();
+}
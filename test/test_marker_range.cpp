@@ -0,0 +1,188 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <random>
+#include <semistable/marker_range.hpp>
+#include <semistable/vector.hpp>
+#include <vector>
+
+using semistable::gravity;
+
+/* eagerly updated range to check marker_range against */
+
+struct reference_range
+{
+  void insert(std::size_t index, std::size_t n)
+  {
+    auto f = first, l = last;
+    if(f > index || (f == index && first_gravity == gravity::right)) f += n;
+    if(l > index || (l == index && last_gravity == gravity::right)) l += n;
+    first = f;
+    last = (std::max)(f, l);
+  }
+
+  void erase(std::size_t index, std::size_t n)
+  {
+    auto collapse = [&] (std::size_t pos) {
+      if(pos >= index + n) return pos - n;
+      else if(pos > index) return index;
+      else return pos;
+    };
+    first = collapse(first);
+    last = collapse(last);
+  }
+
+  std::size_t first, last;
+  gravity     first_gravity, last_gravity;
+};
+
+std::vector<int> make_range(int n)
+{
+  std::vector<int> res;
+  for(int i = 0; i < n; ++i) res.push_back(i);
+  return res;
+}
+
+void test_basic()
+{
+  using vector = semistable::vector<int>;
+  using marker_range = semistable::marker_range<int>;
+  using const_marker_range = semistable::marker_range<const int>;
+
+  auto rng = make_range(20);
+
+  {
+    vector       x{rng.begin(), rng.end()};
+    marker_range r{x, 5, 10};
+    BOOST_TEST(r.first_gravity() == gravity::left);
+    BOOST_TEST(r.last_gravity() == gravity::right);
+    BOOST_TEST_EQ(r.size(), 5u);
+    BOOST_TEST(std::equal(r.begin(), r.end(), rng.begin() + 5));
+
+    /* insertions at the ends grow the range, outside it shift it */
+
+    x.insert(x.begin() + 5, 100);
+    x.insert(x.begin() + 11, 101);
+    x.insert(x.begin() + 8, 102);
+    x.insert(x.begin(), 103);
+    x.push_back(104);
+    BOOST_TEST_EQ(r.first(), 6u);
+    BOOST_TEST_EQ(r.last(), 14u);
+    std::vector<int> expected = {100, 5, 6, 102, 7, 8, 9, 101};
+    BOOST_TEST(std::equal(r.begin(), r.end(), expected.begin()));
+
+    /* erasures shrink it */
+
+    x.erase(x.begin() + 4, x.begin() + 8);
+    BOOST_TEST_EQ(r.first(), 4u);
+    BOOST_TEST_EQ(r.size(), 6u);
+    x.erase(x.begin() + 9, x.begin() + 12);
+    BOOST_TEST_EQ(r.size(), 5u);
+    expected = {6, 102, 7, 8, 9};
+    BOOST_TEST(std::equal(r.begin(), r.end(), expected.begin()));
+    for(auto& v: r) v = -1;
+    BOOST_TEST_EQ(x[4], -1);
+
+    /* down to empty */
+
+    x.erase(x.begin() + 2, x.begin() + 12);
+    BOOST_TEST(r.empty());
+    BOOST_TEST_EQ(r.first(), 2u);
+    x.insert(x.begin() + 2, 105);
+    BOOST_TEST_EQ(r.size(), 1u);
+    BOOST_TEST_EQ(*r.begin(), 105);
+  }
+  {
+    /* inverted gravities: the range doesn't grow at its ends */
+
+    const vector       x{rng.begin(), rng.end()};
+    const_marker_range r{x, 5, 10, gravity::right, gravity::left};
+    const_cast<vector&>(x).insert(x.begin() + 5, 100);
+    const_cast<vector&>(x).insert(x.begin() + 11, 101);
+    BOOST_TEST_EQ(r.first(), 6u);
+    BOOST_TEST_EQ(r.last(), 11u);
+
+    /* an empty range with such gravities stays empty */
+
+    const_marker_range r2{x, 3, 3, gravity::right, gravity::left};
+    const_cast<vector&>(x).insert(x.begin() + 3, 102);
+    BOOST_TEST(r2.empty());
+    BOOST_TEST_EQ(r2.first(), 4u);
+  }
+  {
+    /* the range follows its elements on swap */
+
+    vector       x{rng.begin(), rng.end()}, y;
+    marker_range r{x, 5, 10};
+    x.swap(y);
+    y.erase(y.begin());
+    BOOST_TEST(std::equal(r.begin(), r.end(), rng.begin() + 5));
+  }
+}
+
+void test_random()
+{
+  using vector = semistable::vector<int>;
+  using marker_range = semistable::marker_range<int>;
+
+  auto         rng = make_range(100);
+  std::mt19937 gen(73451);
+  for(int i = 0; i < 20; ++i) {
+    vector                       x{rng.begin(), rng.end()};
+    std::vector<marker_range>    ranges;
+    std::vector<reference_range> refs;
+    for(int j = 0; j < 20; ++j) {
+      std::size_t f = gen() % x.size(), l = f + gen() % (x.size() - f + 1);
+      auto gf = gen() % 2? gravity::left: gravity::right,
+           gl = gen() % 2? gravity::left: gravity::right;
+      ranges.emplace_back(x, f, l, gf, gl);
+      refs.push_back({f, l, gf, gl});
+    }
+
+    for(int j = 0; j < 200; ++j) {
+      if(gen() % 2 || x.size() < 10) {
+        std::size_t index = gen() % (x.size() + 1), n = gen() % 3 + 1;
+        x.insert(x.begin() + (std::ptrdiff_t)index, n, -1);
+        for(auto& r: refs) r.insert(index, n);
+      }
+      else {
+        std::size_t index = gen() % x.size(),
+                    n = (std::min)(x.size() - index, (std::size_t)gen() % 4);
+        x.erase(
+          x.begin() + (std::ptrdiff_t)index,
+          x.begin() + (std::ptrdiff_t)(index + n));
+        for(auto& r: refs) r.erase(index, n);
+      }
+
+      /* some ranges are looked at every now and then, others never */
+
+      auto k = gen() % ranges.size();
+      if(k % 2 == 0) {
+        BOOST_TEST_EQ(ranges[k].first(), refs[k].first);
+        BOOST_TEST_EQ(ranges[k].last(), refs[k].last);
+      }
+    }
+    for(std::size_t k = 0; k < ranges.size(); ++k) {
+      BOOST_TEST_EQ(ranges[k].first(), refs[k].first);
+      BOOST_TEST_EQ(ranges[k].last(), refs[k].last);
+    }
+  }
+}
+
+int main()
+{
+  test_basic();
+  test_random();
+
+  return boost::report_errors();
+}
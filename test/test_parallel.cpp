@@ -0,0 +1,84 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+/* don't make the test depend on linking with TBB */
+#define _GLIBCXX_USE_TBB_PAR_BACKEND 0
+
+#include <boost/core/lightweight_test.hpp>
+#include <semistable/parallel.hpp>
+
+#if !defined(SEMISTABLE_NO_CXX17_HDR_EXECUTION)
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+template<typename T>
+T make_value(std::size_t n) { return T(n); }
+
+template<>
+std::string make_value<std::string>(std::size_t n) { return std::to_string(n); }
+
+template<typename T>
+std::vector<T> make_range(std::size_t n, std::size_t offset)
+{
+  std::vector<T> res;
+  for(std::size_t i = 0; i < n; ++i) res.push_back(make_value<T>(i + offset));
+  return res;
+}
+
+template<typename Vector, typename Policy>
+void test(const Policy& policy)
+{
+  using value_type = typename Vector::value_type;
+
+  auto   rng0 = make_range<value_type>(1000, 0),
+         rng1 = make_range<value_type>(1000, 1);
+  Vector x{rng0.begin(), rng0.end()}, y{rng1.begin(), rng1.end()};
+
+  auto it = x.begin() + 10, last = x.end();
+  semistable::assign(policy, x, y);
+  BOOST_TEST(x == y);
+  BOOST_TEST_EQ(*it, rng1[10]);
+  BOOST_TEST(last == x.end());
+
+  semistable::assign(policy, x, rng0.begin(), rng0.begin() + 500);
+  BOOST_TEST(std::equal(x.begin(), x.end(), rng0.begin(), rng0.begin() + 500));
+  BOOST_TEST_EQ(*it, rng0[10]);
+  BOOST_TEST(last == x.end());
+
+  semistable::assign(policy, x, rng1.begin(), rng1.end());
+  BOOST_TEST(x == y);
+  BOOST_TEST_EQ(*it, rng1[10]);
+  BOOST_TEST(last == x.end());
+
+  Vector z;
+  semistable::assign(policy, z, y);
+  BOOST_TEST(z == y);
+
+  semistable::assign(policy, z, z);
+  BOOST_TEST(z == y);
+}
+
+int main()
+{
+  test<semistable::vector<int>>(std::execution::seq);
+  test<semistable::vector<int>>(std::execution::par);
+  test<semistable::vector<std::string>>(std::execution::seq);
+  test<semistable::vector<std::string>>(std::execution::par_unseq);
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return boost::report_errors();
+}
+#endif
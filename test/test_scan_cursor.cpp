@@ -0,0 +1,200 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <semistable/scan_cursor.hpp>
+#include <semistable/vector.hpp>
+#include <vector>
+
+template<typename T>
+std::vector<T> make_range(std::size_t n)
+{
+  std::vector<T> res;
+  T i = T();
+  while(n--) {
+    res.push_back(i);
+    i += T(1);
+  }
+  return res;
+}
+
+template<typename Cursor>
+std::vector<typename Cursor::value_type>
+scan_all(Cursor& c, std::size_t budget)
+{
+  using value_type = typename Cursor::value_type;
+
+  std::vector<value_type> res;
+  while(c.scan(budget, [&] (const value_type& v) { res.push_back(v); }) ==
+        budget);
+  return res;
+}
+
+template<typename Vector>
+void test()
+{
+  using value_type = typename Vector::value_type;
+  using cursor = semistable::scan_cursor<value_type>;
+  using const_cursor = semistable::scan_cursor<const value_type>;
+
+  auto rng = make_range<value_type>(20);
+
+  {
+    Vector x;
+    cursor c{x};
+    BOOST_TEST(c.done());
+    BOOST_TEST_EQ(c.scan(10, [] (value_type&) {}), 0u);
+  }
+  {
+    Vector x{rng.begin(), rng.end()};
+    cursor c{x};
+    BOOST_TEST(c.policy() == semistable::scan_policy::include_appended);
+    BOOST_TEST(!c.done());
+    BOOST_TEST_EQ(c.remaining(), rng.size());
+    BOOST_TEST(scan_all(c, 3) == rng);
+    BOOST_TEST(c.done());
+    BOOST_TEST_EQ(c.position(), x.size());
+  }
+  {
+    /* const cursor, visitation modifying the vector */
+
+    const Vector cx{rng.begin(), rng.end()};
+    const_cursor c{cx};
+    BOOST_TEST(scan_all(c, 7) == rng);
+
+    Vector x{rng.begin(), rng.end()};
+    cursor c2{x};
+    std::vector<value_type> res;
+    c2.scan(rng.size(), [&] (value_type& v) {
+      res.push_back(v);
+      if(v % 2 == 0) x.insert(x.begin(), v); /* behind the cursor */
+    });
+    BOOST_TEST(res == rng);
+    BOOST_TEST(c2.done());
+  }
+  {
+    /* insertions behind, at and ahead of the cursor */
+
+    Vector x{rng.begin(), rng.end()};
+    cursor c{x};
+    c.scan(5, [] (value_type&) {});
+    BOOST_TEST_EQ(c.position(), 5u);
+    x.insert(x.begin() + 2, 100);
+    BOOST_TEST_EQ(c.position(), 6u);
+    x.insert(x.begin() + 6, 101);
+    x.insert(x.begin() + 10, 102);
+    x.erase(x.begin() + 3, x.begin() + 8);
+    BOOST_TEST_EQ(c.position(), 3u);
+
+    std::vector<value_type> res;
+    c.scan(100, [&] (value_type& v) { res.push_back(v); });
+    std::vector<value_type> expected = {6, 7, 102};
+    expected.insert(expected.end(), rng.begin() + 8, rng.end());
+    BOOST_TEST(res == expected);
+  }
+  {
+    /* scan policies */
+
+    for(auto policy: {
+      semistable::scan_policy::include_appended,
+      semistable::scan_policy::exclude_appended}) {
+      Vector x{rng.begin(), rng.end()};
+      cursor c{x, policy};
+      BOOST_TEST(c.policy() == policy);
+      c.scan(10, [] (value_type&) {});
+      x.push_back(100);
+      x.insert(x.end() - 1, 101);
+      x.erase(x.begin());
+      x.insert(x.begin() + 15, 102);
+
+      std::vector<value_type> res;
+      c.scan(100, [&] (value_type& v) { res.push_back(v); });
+      std::vector<value_type> expected(rng.begin() + 10, rng.begin() + 16);
+      expected.push_back(102);
+      expected.insert(expected.end(), rng.begin() + 16, rng.end());
+      if(policy == semistable::scan_policy::include_appended) {
+        expected.push_back(101);
+        expected.push_back(100);
+      }
+      BOOST_TEST(res == expected);
+      BOOST_TEST(c.done());
+
+      x.push_back(103);
+      BOOST_TEST_EQ(
+        c.done(), policy == semistable::scan_policy::exclude_appended);
+    }
+  }
+  {
+    /* exactly-once visitation under random modifications */
+
+    std::mt19937 gen(98123);
+    for(int i = 0; i < 100; ++i) {
+      Vector                                   x{rng.begin(), rng.end()};
+      std::vector<typename Vector::const_iterator> its;
+      cursor                                   c{x};
+      std::map<value_type, int>                visits;
+      value_type                               next_value =
+                                                 (value_type)rng.size();
+
+      while(!c.done()) {
+        c.scan(gen() % 4, [&] (value_type& v) { ++visits[v]; });
+
+        /* keep some iterators alive so that epochs don't get reused */
+
+        its.push_back(x.cbegin());
+        if(its.size() > 3) its.erase(its.begin());
+
+        switch(gen() % 5) {
+          case 0:
+            x.insert(
+              x.begin() + (std::ptrdiff_t)(gen() % (x.size() + 1)),
+              next_value++);
+            break;
+          case 1:
+            x.push_back(next_value++);
+            break;
+          case 2:
+            if(!x.empty()) {
+              x.erase(x.begin() + (std::ptrdiff_t)(gen() % x.size()));
+            }
+            break;
+          case 3:
+            if(!x.empty()) {
+              auto n = gen() % x.size(),
+                   m = (std::min)(x.size() - n, (std::size_t)(gen() % 4));
+              x.erase(
+                x.begin() + (std::ptrdiff_t)n,
+                x.begin() + (std::ptrdiff_t)(n + m));
+            }
+            break;
+          default:
+            erase_if(x, [&] (const value_type& v) { return v % 7 == i % 7; });
+            break;
+        }
+      }
+
+      for(const auto& p: visits) BOOST_TEST_EQ(p.second, 1);
+      for(const auto& v: x) {
+        if(v < (value_type)rng.size()) BOOST_TEST_EQ(visits[v], 1);
+      }
+    }
+  }
+}
+
+int main()
+{
+  test<semistable::vector<int>>();
+
+  return boost::report_errors();
+}
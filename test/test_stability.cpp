@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <boost/core/lightweight_test.hpp>
+#include <random>
 #include <semistable/vector.hpp>
 #include <type_traits>
 #include <utility>
@@ -246,6 +247,66 @@ void test()
     test_stability(x, [&] { x.clear(); }, keep_none{});
   }
 
+  /* buffer transfer */
+
+  {
+    Vector x{rng.begin(), rng.end()};
+    test_stability(x, [&] {
+      std::vector<value_type, allocator_type> v{rng.begin(), rng.begin() + 5};
+      auto                                    data = v.data();
+      x.adopt(std::move(v));
+      BOOST_TEST_EQ(x.data(), data);
+      BOOST_TEST(std::equal(x.begin(), x.end(), rng.begin()));
+    }, [] (const iterator it) { return *it < 5; });
+  }
+  {
+    Vector x{rng.begin(), rng.end()};
+    auto   data = x.data();
+    test_stability(x, [&] {
+      auto v = x.release();
+      BOOST_TEST_EQ(v.data(), data);
+      BOOST_TEST(std::equal(v.begin(), v.end(), rng.begin()));
+      BOOST_TEST(x.empty());
+    }, keep_none{});
+    x.adopt(std::vector<value_type, allocator_type>(rng.begin(), rng.end()));
+    BOOST_TEST(std::equal(x.begin(), x.end(), rng.begin()));
+  }
+  {
+    Vector x{rng.begin(), rng.end()};
+    auto   it = x.end();
+    x.release();
+    BOOST_TEST(it == x.end());
+    x.push_back(rng[0]);
+    BOOST_TEST(it == x.end());
+  }
+
+  /* uninitialized appending */
+
+  {
+    Vector x{rng.begin(), rng.end()};
+    test_stability(x, [&] {
+      value_type v = 0;
+      auto       filler = [&] (value_type* p, std::size_t m) {
+        for(std::size_t i = 0; i < m; ++i) p[i] = v++;
+        return m;
+      };
+      BOOST_TEST_EQ(x.append_uninitialized(10000, filler), 10000u);
+      BOOST_TEST_EQ(x.size(), rng.size() + 10000);
+      BOOST_TEST_EQ(x.back(), (value_type)9999);
+
+      std::size_t left = 5;
+      BOOST_TEST_EQ(
+        x.append_uninitialized(10, [&] (value_type* p, std::size_t m) {
+          auto k = left < m? left: m;
+          for(std::size_t i = 0; i < k; ++i) p[i] = v++;
+          left -= k;
+          return k;
+        }), 5u);
+      BOOST_TEST_EQ(x.size(), rng.size() + 10005);
+      BOOST_TEST_EQ(x.back(), (value_type)10004);
+    });
+  }
+
   /* erasure */
 
   {
@@ -268,6 +329,136 @@ void test()
     },
     [&] (const iterator it) { return *it != rng[0]; });
   }
+
+  /* unordered erasure */
+
+  {
+    Vector x{rng.begin(), rng.end()};
+    test_stability(x, [&] {
+      BOOST_TEST_EQ(*x.erase_unordered(x.begin() + 3), rng[19]);
+      BOOST_TEST(x.erase_unordered(x.end() - 1) == x.end());
+      BOOST_TEST_EQ(*x.erase_unordered(x.begin()), rng[17]);
+      BOOST_TEST_EQ(x.size(), rng.size() - 3);
+    },
+    [&] (const iterator it) {
+      return *it != rng[0] && *it != rng[3] && *it != rng[18];
+    });
+  }
+  {
+    Vector x{rng.begin(), rng.end()};
+    test_stability(x, [&] {
+      BOOST_TEST_EQ(
+        x.erase_unordered_if([] (const value_type& v) { return v % 2 == 0; }),
+        rng.size() / 2);
+      std::vector<value_type> y{x.begin(), x.end()};
+      std::sort(y.begin(), y.end());
+      for(std::size_t i = 0; i < y.size(); ++i) {
+        BOOST_TEST_EQ(y[i], rng[2 * i + 1]);
+      }
+    },
+    [] (const iterator it) { return *it % 2 != 0;});
+  }
+
+  /* epoch fusion */
+
+  {
+    Vector x{rng.begin(), rng.end()};
+    test_stability(x, [&] {
+      erase_if(x, [] (const value_type& v) {
+        return v == 0 || v == 3 || v == 4 || v == 6 || v == 8 || v == 10;
+      });
+    },
+    [] (const iterator it) { return *it == 5; });
+  }
+  {
+    Vector x{rng.begin(), rng.begin() + 10};
+    test_stability(x, [&] {
+      x.push_back(rng[10]);
+      x.erase(x.begin() + 2);
+      x.insert(x.begin() + 3, rng[19]);
+      x.push_back(rng[11]);
+      x.push_back(rng[12]);
+    },
+    [] (const iterator it) { return *it >= 3; });
+  }
+  {
+    /* unrelated modifications composed while some iterators lag behind */
+
+    Vector            x;
+    std::vector<bool> erased;
+    for(int i = 0; i < 100; ++i) {
+      x.push_back(value_type(i));
+      erased.push_back(false);
+    }
+
+    std::mt19937          gen(25461);
+    std::vector<iterator> its;
+    std::vector<int>      values;
+    for(int i = 0; i < 20; ++i) {
+      its.push_back(x.begin() + (std::ptrdiff_t)(gen() % x.size()));
+      values.push_back((int)*its.back());
+    }
+    its.push_back(x.end());
+
+    for(int i = 0; i < 500; ++i) {
+      if(gen() % 2 || x.size() < 10) {
+        auto index = (std::ptrdiff_t)(gen() % (x.size() + 1));
+        auto n = (int)(gen() % 3 + 1);
+        while(n--) {
+          x.insert(x.begin() + index, value_type((int)erased.size()));
+          erased.push_back(false);
+        }
+      }
+      else {
+        auto index = (std::ptrdiff_t)(gen() % x.size()),
+             n = (std::min)(
+               (std::ptrdiff_t)x.size() - index, (std::ptrdiff_t)gen() % 4);
+        for(auto it = x.begin() + index; it != x.begin() + index + n; ++it) {
+          erased[(std::size_t)*it] = true;
+        }
+        x.erase(x.begin() + index, x.begin() + index + n);
+      }
+
+      /* some iterators are looked at every now and then, others never */
+
+      auto k = gen() % values.size();
+      if(k % 2 == 0 && !erased[(std::size_t)values[k]]) {
+        BOOST_TEST_EQ(*its[k], value_type(values[k]));
+      }
+    }
+    for(std::size_t k = 0; k < values.size(); ++k) {
+      if(!erased[(std::size_t)values[k]]) {
+        BOOST_TEST_EQ(*its[k], value_type(values[k]));
+      }
+    }
+    BOOST_TEST(its.back() == x.end());
+  }
+  {
+    /* reverse iterators */
+
+    Vector x{rng.begin(), rng.end()};
+    auto   rit = x.rbegin() + 5;
+    typename Vector::const_reverse_iterator crit = x.rbegin() + 10;
+    x.insert(x.begin(), rng[0]);
+    x.erase(x.end() - 3, x.end());
+    x.reserve(x.capacity() * 2);
+    BOOST_TEST_EQ(*rit, rng[rng.size() - 6]);
+    BOOST_TEST_EQ(rit[1], rng[rng.size() - 7]);
+    BOOST_TEST_EQ(crit - rit, 5);
+    BOOST_TEST(crit > rit);
+    BOOST_TEST(rit.base() == x.begin() + (std::ptrdiff_t)(rng.size() - 4));
+    BOOST_TEST_EQ(x.rend() - x.rbegin(), (std::ptrdiff_t)x.size());
+  }
+  {
+    /* single iterator at the head of the epoch chain */
+
+    Vector x{rng.begin(), rng.end()};
+    auto   it = x.cbegin() + 5;
+    x.insert(x.begin(), rng[0]);
+    x.insert(x.begin(), rng[1]);
+    x.insert(x.begin(), rng[2]);
+    BOOST_TEST_EQ(*it, rng[5]);
+  }
 }
 
 int main()
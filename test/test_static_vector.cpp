@@ -0,0 +1,255 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <algorithm>
+#include <boost/config.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <semistable/static_vector.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* no memory is allocated by static_vector */
+
+std::size_t num_allocations = 0;
+
+BOOST_NOINLINE void* operator new(std::size_t n)
+{
+  ++num_allocations;
+  if(void* p = std::malloc(n? n: 1)) return p;
+  throw std::bad_alloc();
+}
+
+/* all forms replaced so that deallocations match allocations */
+
+BOOST_NOINLINE void* operator new[](std::size_t n)
+{
+  return operator new(n);
+}
+
+BOOST_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BOOST_NOINLINE void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+BOOST_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+BOOST_NOINLINE void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+struct keep_all
+{
+  template<typename T>
+  bool operator()(const T&) const { return true; }
+};
+
+template<typename Vector, typename F, typename Keep = keep_all>
+void test_stability(Vector& x, F f, Keep keep = {})
+{
+  using value_type = typename Vector::value_type;
+  using const_iterator = typename Vector::const_iterator;
+
+  const_iterator                                     last = x.end();
+  std::vector<std::pair<const_iterator, value_type>> kept;
+  for(auto first = x.cbegin(); first != last; ++first) {
+    if(keep(*first)) kept.push_back({first, *first});
+  }
+
+  auto n = num_allocations;
+  f();
+  BOOST_TEST_EQ(num_allocations, n);
+
+  for(const auto& p: kept) {
+    BOOST_TEST(!p.first.stale());
+    BOOST_TEST_EQ(*(p.first), p.second);
+  }
+  BOOST_TEST(last == x.end());
+}
+
+void test_api()
+{
+  using vector = semistable::static_vector<int, 50>;
+
+  auto n = num_allocations;
+  {
+    vector x;
+    BOOST_TEST(x.empty());
+    BOOST_TEST_EQ(x.capacity(), 50u);
+    for(int i = 0; i < 10; ++i) x.push_back(i);
+    BOOST_TEST_EQ(x.size(), 10u);
+    BOOST_TEST_EQ(x.front(), 0);
+    BOOST_TEST_EQ(x.back(), 9);
+    BOOST_TEST_EQ(x.at(3), 3);
+
+    vector y{x};
+    BOOST_TEST(x == y);
+    y.insert(y.begin() + 2, {100, 101});
+    BOOST_TEST(x < y);
+    BOOST_TEST_EQ(y[2], 100);
+    BOOST_TEST_EQ(y[4], 2);
+    y.erase(y.begin() + 2, y.begin() + 4);
+    BOOST_TEST(x == y);
+
+    y.assign(20, 7);
+    BOOST_TEST_EQ(y.size(), 20u);
+    BOOST_TEST_EQ(std::count(y.begin(), y.end(), 7), 20);
+    y.resize(5);
+    BOOST_TEST_EQ(y.size(), 5u);
+    x.swap(y);
+    BOOST_TEST_EQ(x.size(), 5u);
+    BOOST_TEST_EQ(y.size(), 10u);
+    BOOST_TEST_EQ(erase_if(y, [] (int v) { return v % 2 == 0; }), 5u);
+    BOOST_TEST((y == vector{1, 3, 5, 7, 9}));
+    BOOST_TEST_EQ(erase(y, 5), 1u);
+    BOOST_TEST((y == vector{1, 3, 7, 9}));
+    y.clear();
+    BOOST_TEST(y.empty());
+  }
+  BOOST_TEST_EQ(num_allocations, n);
+
+  {
+    /* exceeding the capacity throws and leaves the vector unchanged */
+
+    semistable::static_vector<int, 5> x{0, 1, 2};
+    auto                              it = x.cbegin() + 1;
+    std::vector<int>                  v(3, 5);
+    BOOST_TEST_THROWS(x.insert(x.begin(), v.begin(), v.end()), std::bad_alloc);
+    BOOST_TEST_THROWS(x.insert(x.begin(), 3, 5), std::bad_alloc);
+    BOOST_TEST_THROWS(x.resize(6), std::bad_alloc);
+    BOOST_TEST_EQ(x.size(), 3u);
+    BOOST_TEST_EQ(*it, 1);
+    x.push_back(3);
+    x.push_back(4);
+    BOOST_TEST_THROWS(x.push_back(5), std::bad_alloc);
+    BOOST_TEST(x.try_push_back(5) == nullptr);
+    x.pop_back();
+    BOOST_TEST(x.try_push_back(5) == &x.back());
+    BOOST_TEST_EQ(*it, 1);
+    BOOST_TEST_THROWS((void)x.at(5), std::out_of_range);
+  }
+  {
+    semistable::static_vector<std::string, 10> x(3, "abc"), y{std::move(x)};
+    BOOST_TEST_EQ(y.size(), 3u);
+    BOOST_TEST_EQ(y[2], "abc");
+    x = y;
+    BOOST_TEST(x == y);
+  }
+}
+
+void test_iterators()
+{
+  using vector = semistable::static_vector<int, 1000, 8>;
+
+  std::vector<int> rng;
+  for(int i = 0; i < 100; ++i) rng.push_back(i);
+
+  vector x{rng.begin(), rng.end()};
+  test_stability(x, [&] { x.insert(x.begin(), -1); });
+  test_stability(x, [&] { x.insert(x.begin() + 10, 3, -1); });
+  test_stability(x, [&] { x.emplace(x.end(), -1); });
+  test_stability(
+    x, [&] { x.erase(x.begin()); }, [] (int v) { return v >= 0; });
+  test_stability(x, [&] {
+    x.insert(x.begin() + 20, rng.begin(), rng.begin() + 10);
+  });
+  test_stability(
+    x, [&] { erase_if(x, [] (int v) { return v < 0; }); },
+    [] (int v) { return v >= 0; });
+  test_stability(x, [&] { x.push_back(-1); });
+
+  {
+    /* consecutive modifications not seen by any iterator are fused (as
+     * iterators pin epochs till they're recycled, even temporaries such as
+     * x.begin() count as seeing a modification)
+     */
+
+    auto it = x.cbegin() + 50;
+    auto v = *it;
+    for(int i = 0; i < 100; ++i) x.push_back(-1);
+    for(int i = 0; i < 100; ++i) x.pop_back();
+    for(int i = 0; i < 100; ++i) x.emplace_back(-1);
+    x.resize(x.size() - 100);
+    BOOST_TEST(!it.stale());
+    BOOST_TEST_EQ(*it, v);
+  }
+  {
+    /* iterators at recycled epochs get stale */
+
+    /* reserved so that iterators aren't copied (and updated) on growth */
+
+    std::vector<vector::const_iterator> its;
+    its.reserve(12);
+    for(int i = 0; i < 6; ++i) {
+      its.push_back(x.cbegin() + 50);
+      if(i % 2 == 0) x.insert(x.begin(), -1);
+      else x.pop_back();
+    }
+    BOOST_TEST(!its[0].stale());
+    for(int i = 0; i < 6; ++i) {
+      its.push_back(x.cbegin() + 50);
+      x.insert(x.begin(), -1);
+    }
+    BOOST_TEST(its[0].stale());
+    BOOST_TEST(!its.back().stale());
+    BOOST_TEST_EQ(*its.back(), x[51]);
+
+    auto it = its.back();
+    its[0] = it;
+    BOOST_TEST(!its[0].stale());
+    BOOST_TEST(its[0] == it);
+    its.clear();
+  }
+  {
+    /* lagging iterators either follow their element or get stale */
+
+    auto it = x.cbegin() + 50;
+    auto v = *it;
+    for(int i = 0; i < 100; ++i) {
+      x.insert(x.begin(), -1);
+      BOOST_TEST(it.stale() || *it == v);
+    }
+  }
+  {
+    /* iterators outliving their container can be assigned and destroyed */
+
+    vector::const_iterator it, it2;
+    {
+      vector y{rng.begin(), rng.begin() + 10};
+      it = y.cbegin() + 5;
+      it2 = it;
+      y.insert(y.begin(), -1);
+    }
+    it2 = it;
+    it = vector::const_iterator{};
+  }
+  {
+    /* iterators stay with their container on swap */
+
+    vector y{rng.begin(), rng.begin() + 10};
+    auto   it = x.cbegin() + 5, it2 = y.cbegin() + 5, last = y.cend();
+    x.swap(y);
+    BOOST_TEST(it == x.cbegin() + 5);
+    BOOST_TEST(it2 == y.cbegin() + 5);
+    BOOST_TEST(last == y.cend());
+    BOOST_TEST_EQ(*it, 5);
+  }
+}
+
+int main()
+{
+  test_api();
+  test_iterators();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,130 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#if !defined(NDEBUG)
+#define SEMISTABLE_ENABLE_INVARIANT_CHECKING
+#endif
+
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <memory>
+#include <semistable/trim.hpp>
+#include <semistable/vector.hpp>
+#include <type_traits>
+
+/* counts the live allocations other than element buffers (i.e. epochs) */
+
+std::size_t live_epochs = 0;
+
+template<typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() = default;
+  template<typename U>
+  counting_allocator(const counting_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n)
+  {
+    if(!std::is_same<T, int>::value) ++live_epochs;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    if(!std::is_same<T, int>::value) --live_epochs;
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  bool operator==(const counting_allocator&) const noexcept { return true; }
+  bool operator!=(const counting_allocator&) const noexcept { return false; }
+};
+
+using vector = semistable::vector<int, counting_allocator<int>>;
+
+void test_trim()
+{
+  {
+    vector x(10);
+    x.reserve(100);
+    for(int i = 0; i < 3; ++i) x.push_back(i);
+    BOOST_TEST_GT(live_epochs, 1u);
+
+    x.trim();
+    BOOST_TEST_EQ(x.capacity(), x.size());
+    BOOST_TEST_EQ(live_epochs, 1u);
+    x.trim();
+    BOOST_TEST_EQ(live_epochs, 1u);
+  }
+  BOOST_TEST_EQ(live_epochs, 0u);
+
+  {
+    /* epochs seen by iterators are kept */
+
+    vector x(10);
+    auto   it0 = x.begin() + 5;
+    x.erase(x.begin());
+    auto   it1 = x.begin() + 5;
+    x.erase(x.begin());
+    x.erase(x.begin());
+    x.erase(x.begin());
+    x.shrink_to_fit();
+
+    /* trim never adds epochs once the capacity is trimmed, and fuses those
+     * not seen by iterators only if the history holds at least three
+     */
+
+    auto n = live_epochs;
+    x.trim();
+    BOOST_TEST_LE(live_epochs, n);
+#if SEMISTABLE_EPOCH_LOOKBACK >= 3
+    BOOST_TEST_LT(live_epochs, n);
+#endif
+    BOOST_TEST(it0 == x.begin() + 1);
+    BOOST_TEST(it1 == x.begin() + 2);
+    BOOST_TEST_EQ(x.capacity(), x.size());
+  }
+  BOOST_TEST_EQ(live_epochs, 0u);
+}
+
+void test_registry()
+{
+  vector x(10), y(10);
+  x.reserve(100);
+  y.reserve(100);
+
+  semistable::trim_registration rx{x};
+  {
+    semistable::trim_registration ry{y};
+
+    BOOST_TEST_EQ(semistable::trim_registered(1), 1u);
+    BOOST_TEST_NE(x.capacity() == x.size(), y.capacity() == y.size());
+    BOOST_TEST_EQ(semistable::trim_registered(1), 1u);
+    BOOST_TEST_EQ(x.capacity(), x.size());
+    BOOST_TEST_EQ(y.capacity(), y.size());
+
+    x.reserve(100);
+    y.reserve(100);
+    BOOST_TEST_EQ(semistable::trim_registered(), 2u);
+    BOOST_TEST_EQ(x.capacity(), x.size());
+    BOOST_TEST_EQ(y.capacity(), y.size());
+    y.reserve(100);
+  }
+
+  x.reserve(100);
+  BOOST_TEST_EQ(semistable::trim_registered(), 1u);
+  BOOST_TEST_EQ(x.capacity(), x.size());
+  BOOST_TEST_EQ(y.capacity(), 100u);
+}
+
+int main()
+{
+  test_trim();
+  test_registry();
+  BOOST_TEST_EQ(semistable::trim_registered(), 0u);
+  return boost::report_errors();
+}